@@ -0,0 +1,102 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/bench/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/tests/CMakeLists.txt"
+  "/root/repo/tests/integration/run_integration_tests.sh.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/DartConfiguration.tcl.in"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "DartConfiguration.tcl"
+  "tests/run_integration_tests.sh"
+  "tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "bench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "src/CMakeFiles/shell_core.dir/DependInfo.cmake"
+  "src/CMakeFiles/shell.dir/DependInfo.cmake"
+  "tests/CMakeFiles/Experimental.dir/DependInfo.cmake"
+  "tests/CMakeFiles/Nightly.dir/DependInfo.cmake"
+  "tests/CMakeFiles/Continuous.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyMemoryCheck.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyStart.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyUpdate.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyConfigure.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyBuild.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyTest.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyCoverage.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlyMemCheck.dir/DependInfo.cmake"
+  "tests/CMakeFiles/NightlySubmit.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalStart.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalUpdate.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalConfigure.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalBuild.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalTest.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalCoverage.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalMemCheck.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ExperimentalSubmit.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousStart.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousUpdate.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousConfigure.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousBuild.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousTest.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousCoverage.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousMemCheck.dir/DependInfo.cmake"
+  "tests/CMakeFiles/ContinuousSubmit.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_runner.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_matcher.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_parser.dir/DependInfo.cmake"
+  "tests/CMakeFiles/test_utils.dir/DependInfo.cmake"
+  "bench/CMakeFiles/shell_bench.dir/DependInfo.cmake"
+  )
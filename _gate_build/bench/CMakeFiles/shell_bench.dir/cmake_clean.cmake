@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/shell_bench"
+  "../bin/shell_bench.pdb"
+  "CMakeFiles/shell_bench.dir/bench.c.o"
+  "CMakeFiles/shell_bench.dir/bench.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/shell_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/shell"
+  "../bin/shell.pdb"
+  "CMakeFiles/shell.dir/main.c.o"
+  "CMakeFiles/shell.dir/main.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/shell.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,40 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/builtins/builtins.c" "src/CMakeFiles/shell_core.dir/builtins/builtins.c.o" "gcc" "src/CMakeFiles/shell_core.dir/builtins/builtins.c.o.d"
+  "/root/repo/src/command/alias.c" "src/CMakeFiles/shell_core.dir/command/alias.c.o" "gcc" "src/CMakeFiles/shell_core.dir/command/alias.c.o.d"
+  "/root/repo/src/command/executor.c" "src/CMakeFiles/shell_core.dir/command/executor.c.o" "gcc" "src/CMakeFiles/shell_core.dir/command/executor.c.o.d"
+  "/root/repo/src/command/input.c" "src/CMakeFiles/shell_core.dir/command/input.c.o" "gcc" "src/CMakeFiles/shell_core.dir/command/input.c.o.d"
+  "/root/repo/src/command/parser.c" "src/CMakeFiles/shell_core.dir/command/parser.c.o" "gcc" "src/CMakeFiles/shell_core.dir/command/parser.c.o.d"
+  "/root/repo/src/command/process_command.c" "src/CMakeFiles/shell_core.dir/command/process_command.c.o" "gcc" "src/CMakeFiles/shell_core.dir/command/process_command.c.o.d"
+  "/root/repo/src/command/redirection.c" "src/CMakeFiles/shell_core.dir/command/redirection.c.o" "gcc" "src/CMakeFiles/shell_core.dir/command/redirection.c.o.d"
+  "/root/repo/src/command/terminal.c" "src/CMakeFiles/shell_core.dir/command/terminal.c.o" "gcc" "src/CMakeFiles/shell_core.dir/command/terminal.c.o.d"
+  "/root/repo/src/completion/completion.c" "src/CMakeFiles/shell_core.dir/completion/completion.c.o" "gcc" "src/CMakeFiles/shell_core.dir/completion/completion.c.o.d"
+  "/root/repo/src/completion/index.c" "src/CMakeFiles/shell_core.dir/completion/index.c.o" "gcc" "src/CMakeFiles/shell_core.dir/completion/index.c.o.d"
+  "/root/repo/src/completion/matcher.c" "src/CMakeFiles/shell_core.dir/completion/matcher.c.o" "gcc" "src/CMakeFiles/shell_core.dir/completion/matcher.c.o.d"
+  "/root/repo/src/history/history.c" "src/CMakeFiles/shell_core.dir/history/history.c.o" "gcc" "src/CMakeFiles/shell_core.dir/history/history.c.o.d"
+  "/root/repo/src/jobs/jobs.c" "src/CMakeFiles/shell_core.dir/jobs/jobs.c.o" "gcc" "src/CMakeFiles/shell_core.dir/jobs/jobs.c.o.d"
+  "/root/repo/src/utils/dircache.c" "src/CMakeFiles/shell_core.dir/utils/dircache.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/dircache.c.o.d"
+  "/root/repo/src/utils/dirjump.c" "src/CMakeFiles/shell_core.dir/utils/dirjump.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/dirjump.c.o.d"
+  "/root/repo/src/utils/error.c" "src/CMakeFiles/shell_core.dir/utils/error.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/error.c.o.d"
+  "/root/repo/src/utils/memory.c" "src/CMakeFiles/shell_core.dir/utils/memory.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/memory.c.o.d"
+  "/root/repo/src/utils/output.c" "src/CMakeFiles/shell_core.dir/utils/output.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/output.c.o.d"
+  "/root/repo/src/utils/path.c" "src/CMakeFiles/shell_core.dir/utils/path.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/path.c.o.d"
+  "/root/repo/src/utils/string.c" "src/CMakeFiles/shell_core.dir/utils/string.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/string.c.o.d"
+  "/root/repo/src/utils/trace.c" "src/CMakeFiles/shell_core.dir/utils/trace.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/trace.c.o.d"
+  "/root/repo/src/utils/utils.c" "src/CMakeFiles/shell_core.dir/utils/utils.c.o" "gcc" "src/CMakeFiles/shell_core.dir/utils/utils.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
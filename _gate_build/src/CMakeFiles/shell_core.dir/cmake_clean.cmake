@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "../lib/libshell_core.a"
+  "../lib/libshell_core.pdb"
+  "CMakeFiles/shell_core.dir/builtins/builtins.c.o"
+  "CMakeFiles/shell_core.dir/builtins/builtins.c.o.d"
+  "CMakeFiles/shell_core.dir/command/alias.c.o"
+  "CMakeFiles/shell_core.dir/command/alias.c.o.d"
+  "CMakeFiles/shell_core.dir/command/executor.c.o"
+  "CMakeFiles/shell_core.dir/command/executor.c.o.d"
+  "CMakeFiles/shell_core.dir/command/input.c.o"
+  "CMakeFiles/shell_core.dir/command/input.c.o.d"
+  "CMakeFiles/shell_core.dir/command/parser.c.o"
+  "CMakeFiles/shell_core.dir/command/parser.c.o.d"
+  "CMakeFiles/shell_core.dir/command/process_command.c.o"
+  "CMakeFiles/shell_core.dir/command/process_command.c.o.d"
+  "CMakeFiles/shell_core.dir/command/redirection.c.o"
+  "CMakeFiles/shell_core.dir/command/redirection.c.o.d"
+  "CMakeFiles/shell_core.dir/command/terminal.c.o"
+  "CMakeFiles/shell_core.dir/command/terminal.c.o.d"
+  "CMakeFiles/shell_core.dir/completion/completion.c.o"
+  "CMakeFiles/shell_core.dir/completion/completion.c.o.d"
+  "CMakeFiles/shell_core.dir/completion/index.c.o"
+  "CMakeFiles/shell_core.dir/completion/index.c.o.d"
+  "CMakeFiles/shell_core.dir/completion/matcher.c.o"
+  "CMakeFiles/shell_core.dir/completion/matcher.c.o.d"
+  "CMakeFiles/shell_core.dir/history/history.c.o"
+  "CMakeFiles/shell_core.dir/history/history.c.o.d"
+  "CMakeFiles/shell_core.dir/jobs/jobs.c.o"
+  "CMakeFiles/shell_core.dir/jobs/jobs.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/dircache.c.o"
+  "CMakeFiles/shell_core.dir/utils/dircache.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/dirjump.c.o"
+  "CMakeFiles/shell_core.dir/utils/dirjump.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/error.c.o"
+  "CMakeFiles/shell_core.dir/utils/error.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/memory.c.o"
+  "CMakeFiles/shell_core.dir/utils/memory.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/output.c.o"
+  "CMakeFiles/shell_core.dir/utils/output.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/path.c.o"
+  "CMakeFiles/shell_core.dir/utils/path.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/string.c.o"
+  "CMakeFiles/shell_core.dir/utils/string.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/trace.c.o"
+  "CMakeFiles/shell_core.dir/utils/trace.c.o.d"
+  "CMakeFiles/shell_core.dir/utils/utils.c.o"
+  "CMakeFiles/shell_core.dir/utils/utils.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/shell_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_matcher"
+  "../bin/test_matcher.pdb"
+  "CMakeFiles/test_matcher.dir/unit/test_matcher.c.o"
+  "CMakeFiles/test_matcher.dir/unit/test_matcher.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_matcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_parser"
+  "../bin/test_parser.pdb"
+  "CMakeFiles/test_parser.dir/unit/test_parser.c.o"
+  "CMakeFiles/test_parser.dir/unit/test_parser.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../lib/libtest_runner.a"
+  "../lib/libtest_runner.pdb"
+  "CMakeFiles/test_runner.dir/framework/test_framework.c.o"
+  "CMakeFiles/test_runner.dir/framework/test_framework.c.o.d"
+  "CMakeFiles/test_runner.dir/framework/test_runner.c.o"
+  "CMakeFiles/test_runner.dir/framework/test_runner.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_runner.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/test_utils"
+  "../bin/test_utils.pdb"
+  "CMakeFiles/test_utils.dir/unit/test_utils.c.o"
+  "CMakeFiles/test_utils.dir/unit/test_utils.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
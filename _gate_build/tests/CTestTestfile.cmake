@@ -0,0 +1,14 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_gate_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_matcher "/root/repo/_gate_build/bin/test_matcher")
+set_tests_properties(test_matcher PROPERTIES  ENVIRONMENT "TEST_MODE=1" TIMEOUT "5" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_parser "/root/repo/_gate_build/bin/test_parser")
+set_tests_properties(test_parser PROPERTIES  ENVIRONMENT "TEST_MODE=1" TIMEOUT "5" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(test_utils "/root/repo/_gate_build/bin/test_utils")
+set_tests_properties(test_utils PROPERTIES  ENVIRONMENT "TEST_MODE=1" TIMEOUT "5" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;35;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(integration_tests "/root/repo/_gate_build/tests/run_integration_tests.sh")
+set_tests_properties(integration_tests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;57;add_test;/root/repo/tests/CMakeLists.txt;0;")
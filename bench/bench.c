@@ -0,0 +1,349 @@
+/**
+ * @file bench.c
+ * @brief Microbenchmarks for the shell's hot paths
+ *
+ * Links shell_core directly and times individual functions with
+ * clock_gettime(CLOCK_MONOTONIC), reporting p50/p99 latency and
+ * iterations/sec for each benchmark. Replaces the coarse wall-clock
+ * timing in tools/performance_test.sh for regression gating.
+ *
+ * Usage: shell_bench [iterations]
+ */
+
+#include "command/command.h"
+#include "completion/completion.h"
+#include "utils/memory.h"
+#include "utils/path.h"
+#include "utils/string.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_ITERATIONS 10000
+#define MAX_SAMPLES 100000
+
+// Each spawn sample forks a whole shell, so cap this benchmark well
+// below the in-process iteration count
+#define MAX_SPAWN_SAMPLES 300
+
+// Synthetic PATH directory used by the path/completion benchmarks
+#define BENCH_PATH_DIR "/tmp/cshell_bench_path"
+#define BENCH_PATH_ENTRIES 10000
+
+static long samples[MAX_SAMPLES];
+
+/**
+ * @brief Read the monotonic clock in nanoseconds
+ *
+ * @return long Current time in ns
+ */
+static long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/**
+ * @brief Compare two samples for qsort
+ */
+static int compare_samples(const void *a, const void *b) {
+    long la = *(const long *)a;
+    long lb = *(const long *)b;
+    return (la > lb) - (la < lb);
+}
+
+/**
+ * @brief Report one benchmark's statistics
+ *
+ * Sorts the collected samples and prints p50, p99, and iterations/sec.
+ *
+ * @param name Benchmark name
+ * @param count Number of samples collected
+ */
+static void report(const char *name, int count) {
+    if (count == 0) {
+        printf("%-28s no samples\n", name);
+        return;
+    }
+
+    qsort(samples, count, sizeof(long), compare_samples);
+
+    long total = 0;
+    for (int i = 0; i < count; i++) {
+        total += samples[i];
+    }
+
+    long p50 = samples[count / 2];
+    long p99 = samples[(int)(count * 0.99)];
+    double iters_per_sec = count / (total / 1e9);
+
+    printf("%-28s p50 %8ld ns   p99 %8ld ns   %12.0f iters/sec\n",
+           name, p50, p99, iters_per_sec);
+}
+
+/**
+ * @brief Benchmark the single-pass tokenizer and the legacy parser
+ *
+ * Runs each line of a representative corpus through the parsers,
+ * one sample per line.
+ *
+ * @param iterations Number of corpus passes
+ */
+static void bench_parse(int iterations) {
+    static const char *corpus[] = {
+        "echo hello world",
+        "ls -la /usr/local/bin",
+        "grep -r \"some pattern\" src include",
+        "echo \"quoted arg\" 'another one' plain > /tmp/out.txt",
+        "cat file.txt 2>> /tmp/err.log",
+        "cc -O2 -Wall -Wextra -c parser.c -o parser.o",
+    };
+    int corpus_size = (int)(sizeof(corpus) / sizeof(corpus[0]));
+    int count = 0;
+
+    for (int i = 0; i < iterations && count < MAX_SAMPLES; i++) {
+        const char *line = corpus[i % corpus_size];
+
+        long start = now_ns();
+        char *copy = arena_strdup(line);
+        Command cmd;
+        memset(&cmd, 0, sizeof(cmd));
+        parse_command_line(copy, &cmd);
+        samples[count++] = now_ns() - start;
+
+        arena_reset();
+    }
+
+    report("parse_command_line", count);
+
+    count = 0;
+    for (int i = 0; i < iterations && count < MAX_SAMPLES; i++) {
+        const char *line = corpus[i % corpus_size];
+
+        long start = now_ns();
+        char *copy = arena_strdup(line);
+        Command cmd;
+        memset(&cmd, 0, sizeof(cmd));
+        initialize_redirection_info(&cmd.redir);
+        parse_redirections(copy, &cmd.redir);
+        parse_command(copy, &cmd);
+        samples[count++] = now_ns() - start;
+
+        arena_reset();
+    }
+
+    report("parse_redirections+command", count);
+}
+
+/**
+ * @brief Populate the synthetic PATH directory
+ *
+ * Creates BENCH_PATH_ENTRIES empty executable files so path and
+ * completion lookups run against a realistic large bin directory.
+ *
+ * @return int 0 on success, non-zero on error
+ */
+static int setup_bench_path(void) {
+    if (mkdir(BENCH_PATH_DIR, 0755) != 0 && access(BENCH_PATH_DIR, F_OK) != 0) {
+        perror("mkdir");
+        return -1;
+    }
+
+    char path[256];
+    for (int i = 0; i < BENCH_PATH_ENTRIES; i++) {
+        snprintf(path, sizeof(path), BENCH_PATH_DIR "/bench_cmd_%05d", i);
+        if (access(path, F_OK) != 0) {
+            FILE *fp = fopen(path, "w");
+            if (!fp) {
+                perror("fopen");
+                return -1;
+            }
+            fclose(fp);
+            chmod(path, 0755);
+        }
+    }
+
+    setenv("PATH", BENCH_PATH_DIR, 1);
+    return 0;
+}
+
+/**
+ * @brief Benchmark PATH lookups through the executable cache
+ *
+ * Measures both the hit path (existing command) and the miss path.
+ *
+ * @param iterations Number of lookups
+ */
+static void bench_path_search(int iterations) {
+    int count = 0;
+
+    for (int i = 0; i < iterations && count < MAX_SAMPLES; i++) {
+        char name[64];
+        snprintf(name, sizeof(name), "bench_cmd_%05d", i % BENCH_PATH_ENTRIES);
+
+        long start = now_ns();
+        path_search_cached(name);
+        samples[count++] = now_ns() - start;
+    }
+
+    report("path_search_cached hit", count);
+
+    count = 0;
+    for (int i = 0; i < iterations && count < MAX_SAMPLES; i++) {
+        long start = now_ns();
+        path_search_cached("no_such_command_here");
+        samples[count++] = now_ns() - start;
+    }
+
+    report("path_search_cached miss", count);
+}
+
+/**
+ * @brief Benchmark command completion against the synthetic PATH
+ *
+ * @param iterations Number of completion queries
+ */
+static void bench_completions(int iterations) {
+    int count = 0;
+
+    for (int i = 0; i < iterations && count < MAX_SAMPLES; i++) {
+        char **completions = NULL;
+        int num_completions = 0;
+
+        long start = now_ns();
+        get_all_completions("bench_cmd_001", 1, &completions, &num_completions);
+        samples[count++] = now_ns() - start;
+
+        for (int j = 0; j < num_completions; j++) {
+            free(completions[j]);
+        }
+        free(completions);
+    }
+
+    report("get_all_completions", count);
+}
+
+/**
+ * @brief Benchmark string utility throughput
+ *
+ * @param iterations Number of calls per function
+ */
+static void bench_strings(int iterations) {
+    const char *text = "the quick brown fox jumps over the lazy dog "
+                       "the quick brown fox jumps over the lazy dog";
+    int count = 0;
+
+    for (int i = 0; i < iterations && count < MAX_SAMPLES; i++) {
+        long start = now_ns();
+        char *replaced = str_replace(text, "fox", "badger");
+        samples[count++] = now_ns() - start;
+
+        free(replaced);
+    }
+
+    report("str_replace", count);
+
+    count = 0;
+    for (int i = 0; i < iterations && count < MAX_SAMPLES; i++) {
+        int num_parts = 0;
+
+        long start = now_ns();
+        char **parts = str_split(text, ' ', &num_parts);
+        samples[count++] = now_ns() - start;
+
+        str_split_free(parts, num_parts);
+    }
+
+    report("str_split", count);
+}
+
+/**
+ * @brief Benchmark full shell startup in batch mode
+ *
+ * Times fork + exec + `shell -c true` + wait per sample, the cost a
+ * CI wrapper pays for every command it runs through the shell. Batch
+ * mode loads no history, jump index, or completion index, so this is
+ * the floor for spawn latency. The shell binary is taken from
+ * $CSHELL_BIN, defaulting to ./bin/shell next to this benchmark.
+ *
+ * @param iterations Requested iteration count (capped)
+ */
+static void bench_spawn(int iterations) {
+    const char *shell_bin = getenv("CSHELL_BIN");
+    if (!shell_bin) {
+        shell_bin = "./bin/shell";
+    }
+
+    if (access(shell_bin, X_OK) != 0) {
+        printf("%-28s skipped (%s not executable; set CSHELL_BIN)\n",
+               "spawn shell -c true", shell_bin);
+        return;
+    }
+
+    if (iterations > MAX_SPAWN_SAMPLES) {
+        iterations = MAX_SPAWN_SAMPLES;
+    }
+
+    int count = 0;
+    for (int i = 0; i < iterations; i++) {
+        long start = now_ns();
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            execl(shell_bin, shell_bin, "-c", "true", (char *)NULL);
+            _exit(127);
+        }
+        if (pid < 0) {
+            break;
+        }
+
+        int wstatus;
+        waitpid(pid, &wstatus, 0);
+        samples[count++] = now_ns() - start;
+
+        if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+            printf("%-28s skipped (%s -c true failed)\n",
+                   "spawn shell -c true", shell_bin);
+            return;
+        }
+    }
+
+    report("spawn shell -c true", count);
+}
+
+/**
+ * @brief Benchmark entry point
+ */
+int main(int argc, char *argv[]) {
+    int iterations = DEFAULT_ITERATIONS;
+
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (iterations > MAX_SAMPLES) {
+        iterations = MAX_SAMPLES;
+    }
+
+    printf("shell microbenchmarks (%d iterations each)\n\n", iterations);
+
+    bench_parse(iterations);
+    bench_strings(iterations);
+
+    if (setup_bench_path() == 0) {
+        bench_path_search(iterations);
+        bench_completions(iterations);
+    }
+
+    bench_spawn(iterations);
+
+    arena_destroy();
+    return 0;
+}
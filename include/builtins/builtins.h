@@ -95,9 +95,105 @@ int builtin_pwd(Command *cmd);
  */
 int builtin_type(Command *cmd);
 
+/**
+ * @brief alias built-in
+ *
+ * @param cmd Command structure
+ * @return int 0 on success, 1 if a lookup failed
+ */
+int builtin_alias(Command *cmd);
+
+/**
+ * @brief unalias built-in
+ *
+ * @param cmd Command structure
+ * @return int 0 on success, 1 on error
+ */
+int builtin_unalias(Command *cmd);
+
+/**
+ * @brief true built-in
+ *
+ * @param cmd Command structure
+ * @return int Always 0
+ */
+int builtin_true(Command *cmd);
+
+/**
+ * @brief false built-in
+ *
+ * @param cmd Command structure
+ * @return int Always 1
+ */
+int builtin_false(Command *cmd);
+
+/**
+ * @brief test / [ built-in
+ *
+ * @param cmd Command structure
+ * @return int 0 if true, 1 if false, 2 on error
+ */
+int builtin_test(Command *cmd);
+
+/**
+ * @brief time built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status of the wrapped command
+ */
+int builtin_time(Command *cmd);
+
+/**
+ * @brief printf built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_printf(Command *cmd);
+
+/**
+ * @brief jobs (list background jobs) built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_jobs(Command *cmd);
+
+/**
+ * @brief fg (wait for a job in the foreground) built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status of the job
+ */
+int builtin_fg(Command *cmd);
+
+/**
+ * @brief wait built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_wait(Command *cmd);
+
+/**
+ * @brief log (deferred error log) built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_log(Command *cmd);
+
+/**
+ * @brief stats (latency histograms) built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_stats(Command *cmd);
+
 /**
  * @brief help built-in
- * 
+ *
  * @param cmd Command structure
  * @return int Exit status
  */
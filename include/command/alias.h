@@ -0,0 +1,60 @@
+/**
+ * @file alias.h
+ * @brief Command alias table
+ *
+ * A hash table of command aliases. Each alias stores its replacement
+ * both as text (for printing) and pre-tokenized (for splicing into
+ * argv at parse time without reparsing the line).
+ */
+
+#ifndef ALIAS_H
+#define ALIAS_H
+
+/**
+ * @brief Define or replace an alias
+ *
+ * The value is tokenized once here, so every later expansion is a
+ * straight splice.
+ *
+ * @param name Alias name
+ * @param value Replacement text
+ * @return int 0 on success, non-zero on error
+ */
+int alias_set(const char *name, const char *value);
+
+/**
+ * @brief Look up an alias's replacement text
+ *
+ * @param name Alias name
+ * @return const char* Replacement text, NULL if not defined
+ */
+const char *alias_get(const char *name);
+
+/**
+ * @brief Look up an alias's pre-tokenized replacement
+ *
+ * @param name Alias name
+ * @param num_tokens Out: number of tokens
+ * @return char** Token array (table-owned), NULL if not defined
+ */
+char **alias_tokens(const char *name, int *num_tokens);
+
+/**
+ * @brief Remove an alias
+ *
+ * @param name Alias name
+ * @return int 0 on success, non-zero if not defined
+ */
+int alias_remove(const char *name);
+
+/**
+ * @brief Print all defined aliases
+ */
+void alias_print(void);
+
+/**
+ * @brief Remove all aliases and release the table
+ */
+void alias_cleanup(void);
+
+#endif /* ALIAS_H */
@@ -36,6 +36,39 @@ typedef struct {
     RedirectionInfo redir; /**< Redirection information */
 } Command;
 
+/**
+ * @brief Chain operator
+ *
+ * How a chain segment is joined to the one before it.
+ */
+typedef enum {
+    CHAIN_SEQ,    /**< ';' - run unconditionally */
+    CHAIN_AND,    /**< '&&' - run only if the previous segment succeeded */
+    CHAIN_OR      /**< '||' - run only if the previous segment failed */
+} ChainOperator;
+
+/**
+ * @brief Command chain structure
+ *
+ * A command line split at unquoted ';', '&&', and '||' operators.
+ * Segments are executed sequentially with short-circuit evaluation.
+ */
+typedef struct {
+    char **segments;          /**< Segment strings (into the input buffer) */
+    ChainOperator *operators; /**< operators[i] joins segment i to i-1 */
+    int num_segments;         /**< Number of segments */
+} CommandChain;
+
+/**
+ * @brief Pipeline structure
+ *
+ * Holds a sequence of commands connected by pipes.
+ */
+typedef struct {
+    Command *commands;    /**< Array of pipeline stages */
+    int num_commands;     /**< Number of stages */
+} Pipeline;
+
 /**
  * @brief Initialize redirection info
  * 
@@ -75,9 +108,23 @@ void free_command(Command *cmd);
  */
 int parse_command(char *input, Command *cmd);
 
+/**
+ * @brief Tokenize a command line in a single pass
+ *
+ * Unified tokenizer: one scan handles quote/escape state, argv words
+ * and redirections. Words are compacted in place, so the Command's
+ * argv points into the input buffer - the input must be arena memory
+ * that outlives the command.
+ *
+ * @param input Input string to parse (must be arena memory; modified)
+ * @param cmd Pointer to Command structure to fill
+ * @return int 0 on success, non-zero on error
+ */
+int parse_command_line(char *input, Command *cmd);
+
 /**
  * @brief Parse redirections
- * 
+ *
  * Extracts redirection operators from input and sets up RedirectionInfo.
  * Modifies input string to remove redirection operators.
  * 
@@ -121,12 +168,101 @@ int execute_builtin_command(Command *cmd);
 
 /**
  * @brief Execute an external command
- * 
+ *
  * Executes the command as an external program.
- * 
+ *
  * @param cmd Pointer to Command structure
  * @return int Exit status of the command, -1 on error
  */
 int execute_external_command(Command *cmd);
 
+/**
+ * @brief Execute an external command in the background
+ *
+ * Launches the command without waiting and records it in the job
+ * table for SIGCHLD-driven reaping.
+ *
+ * @param cmd Pointer to Command structure
+ * @param cmdline Command line as typed (recorded in the job table)
+ * @return int 0 on success, -1 on error, 127 if not found
+ */
+int execute_external_command_background(Command *cmd, const char *cmdline);
+
+/**
+ * @brief Split a command line at chain operators
+ *
+ * Splits the input at unquoted ';', '&&', and '||' into a
+ * CommandChain, recording how each segment joins the previous one.
+ * The chain's arrays live in the command arena.
+ *
+ * @param input Input string to split (will be modified)
+ * @param chain Pointer to CommandChain structure to fill
+ * @return int 0 on success, non-zero on error
+ */
+int parse_command_chain(char *input, CommandChain *chain);
+
+/**
+ * @brief Strip a trailing background operator
+ *
+ * Removes an unquoted trailing '&' from the line if present.
+ *
+ * @param input Command string to scan (will be modified)
+ * @return int 1 if a background operator was stripped, 0 otherwise
+ */
+int strip_background_operator(char *input);
+
+/**
+ * @brief Check for an unquoted pipe operator
+ *
+ * Scans a command line for a '|' outside quotes and escapes.
+ *
+ * @param input Command string to scan
+ * @return int 1 if the line contains a pipeline, 0 otherwise
+ */
+int contains_unquoted_pipe(const char *input);
+
+/**
+ * @brief Parse a command line into a pipeline
+ *
+ * Splits the input at unquoted '|' operators and parses each stage
+ * into a Command (including its redirections).
+ *
+ * @param input Input string to parse (will be modified)
+ * @param pipeline Pointer to Pipeline structure to fill
+ * @return int 0 on success, non-zero on error
+ */
+int parse_pipeline(char *input, Pipeline *pipeline);
+
+/**
+ * @brief Free pipeline resources
+ *
+ * Frees memory allocated for a Pipeline structure.
+ *
+ * @param pipeline Pointer to Pipeline structure
+ */
+void free_pipeline(Pipeline *pipeline);
+
+/**
+ * @brief Execute a pipeline
+ *
+ * Spawns all pipeline stages concurrently, connected by pipes, and
+ * waits for them to finish.
+ *
+ * @param pipeline Pointer to Pipeline structure
+ * @return int Exit status of the last stage, -1 on error
+ */
+int execute_pipeline(Pipeline *pipeline);
+
+/**
+ * @brief Execute a pipeline in the background
+ *
+ * Spawns all stages without waiting and records the last stage in
+ * the job table for SIGCHLD-driven reaping.
+ *
+ * @param pipeline Pointer to Pipeline structure
+ * @param cmdline Command line as typed (recorded in the job table)
+ * @return int 0 on success, -1 on error
+ */
+int execute_pipeline_background(Pipeline *pipeline, const char *cmdline);
+
 #endif /* COMMAND_H */
\ No newline at end of file
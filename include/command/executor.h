@@ -1,70 +1,76 @@
 /**
- * @file parser.h
- * @brief Command parsing component
+ * @file executor.h
+ * @brief Command execution component
  *
- * Functions for parsing command input into arguments and redirection operators.
+ * Functions for executing built-in and external commands.
  */
 
-#ifndef PARSER_H
-#define PARSER_H
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
 
 #include "command.h"
+#include <sys/types.h>
 
 /**
- * @brief Parse a command line into tokens
- * 
- * Parses a command line into tokens, respecting quotes and escape characters.
- * 
- * @param line Input command line
- * @param tokens Array to store tokens (must be preallocated)
- * @param max_tokens Maximum number of tokens to parse
- * @return int Number of tokens parsed
+ * @brief Find an executable in PATH
+ *
+ * Searches for an executable in the directories specified by PATH.
+ *
+ * @param command Command name to search for
+ * @return const char* Interned path to executable (do not free) or NULL if not found
  */
-int tokenize_command(const char *line, char **tokens, int max_tokens);
+const char *find_executable(const char *command);
 
 /**
- * @brief Parse echo command arguments
- * 
- * Special handling for echo command arguments with escape sequences.
- * 
- * @param input Input arguments string
- * @param output Output buffer for processed arguments
- * @param output_size Size of output buffer
+ * @brief Execute a command
+ *
+ * Execute a command, either built-in or external.
+ *
+ * @param cmd Pointer to Command structure
+ * @return int Exit status of the command
  */
-void parse_echo_args(const char *input, char *output, size_t output_size);
+int execute_command(Command *cmd);
 
 /**
- * @brief Process escape sequences
- * 
- * Processes escape sequences in a string.
- * 
- * @param input Input string with escape sequences
- * @param output Output buffer for processed string
- * @param output_size Size of output buffer
- * @return size_t Number of bytes written to output
+ * @brief Create a child process for command execution
+ *
+ * Forks a child process for executing external commands.
+ *
+ * @param cmd Pointer to Command structure
+ * @return int Process ID of the child, -1 on error
  */
-size_t process_escapes(const char *input, char *output, size_t output_size);
+pid_t create_process(Command *cmd);
 
 /**
- * @brief Handle quotes in a string
- * 
- * Removes quotes and handles quoted content.
- * 
- * @param input Input string with quotes
- * @param output Output buffer for processed string
- * @param output_size Size of output buffer
- * @return size_t Number of bytes written to output
+ * @brief Wait for a child process to complete
+ *
+ * Waits for a child process to exit and returns its status.
+ *
+ * @param pid Process ID to wait for
+ * @return int Exit status of the process
  */
-size_t process_quotes(const char *input, char *output, size_t output_size);
+int wait_for_process(pid_t pid);
 
 /**
- * @brief Validates command syntax
- * 
- * Checks for syntax errors in a command string.
- * 
- * @param input Command string to validate
- * @return int 0 if syntax is valid, error code otherwise
+ * @brief Execute command in child process
+ *
+ * Executes a command in a child process using execv.
+ * This function does not return if successful.
+ *
+ * @param cmd Pointer to Command structure
+ * @param path Path to executable
+ * @return int -1 on error (only returns on error)
+ */
+int exec_command(Command *cmd, const char *path);
+
+/**
+ * @brief Check if a path is executable
+ *
+ * Checks if a file exists and is executable.
+ *
+ * @param path Path to check
+ * @return int 1 if executable, 0 otherwise
  */
-int validate_command_syntax(const char *input);
+int is_executable(const char *path);
 
-#endif /* PARSER_H */
\ No newline at end of file
+#endif /* EXECUTOR_H */
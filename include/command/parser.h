@@ -9,6 +9,7 @@
 #define PARSER_H
 
 #include "command.h"
+#include "../utils/string.h"
 
 /**
  * @brief Parse a command line into tokens
@@ -24,38 +25,36 @@ int tokenize_command(const char *line, char **tokens, int max_tokens);
 
 /**
  * @brief Parse echo command arguments
- * 
+ *
  * Special handling for echo command arguments with escape sequences.
- * 
+ * Appends to the caller's string builder, so there is no length cap.
+ *
  * @param input Input arguments string
- * @param output Output buffer for processed arguments
- * @param output_size Size of output buffer
+ * @param output Builder for the processed arguments (appended to)
  */
-void parse_echo_args(const char *input, char *output, size_t output_size);
+void parse_echo_args(const char *input, StrBuilder *output);
 
 /**
  * @brief Process escape sequences
- * 
+ *
  * Processes escape sequences in a string.
- * 
+ *
  * @param input Input string with escape sequences
- * @param output Output buffer for processed string
- * @param output_size Size of output buffer
- * @return size_t Number of bytes written to output
+ * @param output Builder for the processed string (appended to)
+ * @return size_t Number of bytes appended to output
  */
-size_t process_escapes(const char *input, char *output, size_t output_size);
+size_t process_escapes(const char *input, StrBuilder *output);
 
 /**
  * @brief Handle quotes in a string
- * 
+ *
  * Removes quotes and handles quoted content.
- * 
+ *
  * @param input Input string with quotes
- * @param output Output buffer for processed string
- * @param output_size Size of output buffer
- * @return size_t Number of bytes written to output
+ * @param output Builder for the processed string (appended to)
+ * @return size_t Number of bytes appended to output
  */
-size_t process_quotes(const char *input, char *output, size_t output_size);
+size_t process_quotes(const char *input, StrBuilder *output);
 
 /**
  * @brief Validates command syntax
@@ -10,6 +10,35 @@
 
 #include "command.h"
 
+/** Open append-mode fds kept across commands */
+#define REDIR_FD_CACHE_SLOTS 8
+
+/**
+ * @brief Open a redirection target, reusing cached append fds
+ *
+ * Append-mode targets are served from a small LRU of open fds keyed
+ * by (path, flags), so a loop appending to the same log pays one
+ * open() for the whole session; O_APPEND makes the write position a
+ * property of the file, so the long-lived fd behaves exactly like a
+ * fresh open, concurrent writers included. Truncating opens always
+ * really reopen. Cached fds are opened with O_CLOEXEC so they never
+ * leak into children.
+ *
+ * @param path Target filename
+ * @param flags open() flags
+ * @param cached Out: set non-zero when the returned fd is owned by
+ *               the cache and must not be closed by the caller
+ * @return int Open file descriptor, -1 on error
+ */
+int redir_fd_get(const char *path, int flags, int *cached);
+
+/**
+ * @brief Close all cached redirection fds
+ *
+ * Flushes the cache; called from shell_cleanup().
+ */
+void redir_fd_cache_destroy(void);
+
 /**
  * @brief Parse redirection operators
  * 
@@ -8,6 +8,81 @@
 #ifndef COMPLETION_H
 #define COMPLETION_H
 
+#include <stddef.h>
+
+/** Maximum candidates kept per completion pass; the total match
+ *  count and longest common prefix still cover everything seen */
+#define COMPLETION_SET_CAP 256
+
+/** Longest tracked common prefix */
+#define COMPLETION_LCP_MAX 1024
+
+/**
+ * @brief Streamed completion results
+ *
+ * Matches are fed in one at a time: the longest common prefix and
+ * total count are maintained incrementally over everything, while at
+ * most COMPLETION_SET_CAP candidate names are kept, packed into one
+ * reusable byte pool instead of per-entry allocations.
+ */
+typedef struct {
+    char *pool;                    /**< Packed candidate names */
+    size_t pool_len;               /**< Bytes used */
+    size_t pool_capacity;          /**< Bytes allocated */
+    size_t offsets[COMPLETION_SET_CAP];  /**< Name offsets into pool */
+    int count;                     /**< Candidates kept (capped) */
+    int total;                     /**< Total matches seen */
+    char lcp[COMPLETION_LCP_MAX];  /**< Longest common prefix */
+    int lcp_len;                   /**< Length of lcp */
+} CompletionSet;
+
+/**
+ * @brief Reset a completion set for reuse
+ *
+ * Clears the counters but keeps the pool allocation.
+ *
+ * @param set Set to reset
+ */
+void completion_set_reset(CompletionSet *set);
+
+/**
+ * @brief Stream one match into a completion set
+ *
+ * Updates the total and the longest common prefix unconditionally;
+ * stores the name (plus a trailing slash for directories) only while
+ * under the cap.
+ *
+ * @param set Set to add to
+ * @param name Matching name
+ * @param is_dir Non-zero to append a trailing slash
+ * @return int 0 on success, non-zero on error
+ */
+int completion_set_add(CompletionSet *set, const char *name, int is_dir);
+
+/**
+ * @brief Get a stored candidate by index
+ *
+ * @param set Completion set
+ * @param index Candidate index (0 .. count-1)
+ * @return const char* Candidate name, NULL if out of range
+ */
+const char *completion_set_get(const CompletionSet *set, int index);
+
+/**
+ * @brief Collect completions for a prefix into a set
+ *
+ * Streaming replacement for get_all_completions(): command prefixes
+ * answer from the executable index, paths and arguments from the
+ * shared directory-listing cache, all through completion_set_add().
+ *
+ * @param prefix Prefix to complete
+ * @param is_command Non-zero if the prefix is the command word
+ * @param set Set to fill (reset first)
+ * @return int 0 on success, non-zero on error
+ */
+int completion_stream_collect(const char *prefix, int is_command,
+                              CompletionSet *set);
+
 /**
  * @brief Handle tab completion
  * 
@@ -20,14 +95,18 @@ void handle_tab_completion(char *input, int *cursor_pos);
 
 /**
  * @brief Get all possible completions
- * 
- * Find all possible completions for a given prefix.
- * 
+ *
+ * Find all possible completions for a given prefix. Command
+ * completions come from the prebuilt executable index; path and
+ * argument completions scan the relevant directory.
+ *
  * @param prefix Prefix to complete
+ * @param is_command Non-zero if the prefix is the command word
  * @param completions_ptr Pointer to store completions array
  * @param num_completions_ptr Pointer to store number of completions
  */
-void get_all_completions(const char *prefix, char ***completions_ptr, int *num_completions_ptr);
+void get_all_completions(const char *prefix, int is_command,
+                         char ***completions_ptr, int *num_completions_ptr);
 
 /**
  * @brief Find the longest common prefix
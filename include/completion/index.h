@@ -0,0 +1,41 @@
+/**
+ * @file index.h
+ * @brief Executable name index for tab completion
+ *
+ * Maintains a sorted, deduplicated in-memory index of all built-in
+ * and PATH executable names so command completion never has to scan
+ * PATH directories on a keystroke.
+ */
+
+#ifndef INDEX_H
+#define INDEX_H
+
+/**
+ * @brief Look up command completions in the index
+ *
+ * Ensures the index is current (rebuilding it if $PATH changed or a
+ * PATH directory's mtime changed), then binary-searches the sorted
+ * name array for the range matching the prefix.
+ *
+ * @param prefix Prefix to complete
+ * @param num_matches Pointer to store number of matches
+ * @return char** Array of matching names (caller must free with
+ *         free_completions), NULL if there are no matches
+ */
+char **completion_index_lookup(const char *prefix, int *num_matches);
+
+/**
+ * @brief Force a rebuild of the executable index
+ *
+ * Drops the current index; it is rebuilt on the next lookup.
+ */
+void completion_index_invalidate(void);
+
+/**
+ * @brief Destroy the executable index
+ *
+ * Frees all index storage. Called on shell shutdown.
+ */
+void completion_index_destroy(void);
+
+#endif /* INDEX_H */
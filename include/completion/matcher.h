@@ -86,13 +86,78 @@ int filter_completions(char **completions, int *num_completions, int (*predicate
 
 /**
  * @brief Sort and deduplicate completions
- * 
+ *
  * Sorts completions alphabetically and removes duplicates.
- * 
+ *
  * @param completions Array of completions
  * @param num_completions Pointer to number of completions
  * @return int New number of completions
  */
 int sort_and_deduplicate(char **completions, int *num_completions);
 
+/** Maximum query length for incremental matching */
+#define MATCHER_QUERY_MAX 256
+
+/**
+ * @brief Incremental substring matcher state
+ *
+ * Holds the surviving candidate set for an interactive search. Each
+ * added query character filters the previous result set rather than
+ * rescanning every candidate, so narrowing a search over tens of
+ * thousands of entries stays cheap per keystroke.
+ */
+typedef struct {
+    const char **candidates;     /**< Borrowed candidate array */
+    int num_candidates;          /**< Total number of candidates */
+    int *matches;                /**< Indices of surviving candidates */
+    int num_matches;             /**< Number of surviving candidates */
+    char query[MATCHER_QUERY_MAX]; /**< Current query string */
+    int query_len;               /**< Current query length */
+} IncrementalMatcher;
+
+/**
+ * @brief Initialize an incremental matcher
+ *
+ * Starts with an empty query, so every candidate matches. The
+ * candidate array is borrowed and must outlive the matcher.
+ *
+ * @param im Matcher state to initialize
+ * @param candidates Array of candidate strings
+ * @param num_candidates Number of candidates
+ * @return int 0 on success, non-zero on error
+ */
+int incremental_matcher_init(IncrementalMatcher *im,
+                             const char **candidates, int num_candidates);
+
+/**
+ * @brief Append a character to the query
+ *
+ * Narrows the surviving set in place: a candidate containing the
+ * longer query necessarily contained the shorter one, so only the
+ * previous matches are rechecked.
+ *
+ * @param im Matcher state
+ * @param c Character to append
+ * @return int Number of surviving matches
+ */
+int incremental_matcher_push(IncrementalMatcher *im, char c);
+
+/**
+ * @brief Remove the last character from the query
+ *
+ * Widening cannot reuse the narrowed set, so the full candidate
+ * array is rescanned with the shorter query.
+ *
+ * @param im Matcher state
+ * @return int Number of surviving matches
+ */
+int incremental_matcher_pop(IncrementalMatcher *im);
+
+/**
+ * @brief Clean up an incremental matcher
+ *
+ * @param im Matcher state to clean up
+ */
+void incremental_matcher_free(IncrementalMatcher *im);
+
 #endif /* MATCHER_H */
\ No newline at end of file
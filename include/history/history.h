@@ -0,0 +1,66 @@
+/**
+ * @file history.h
+ * @brief Command history component
+ *
+ * Persistent command history. Past sessions are loaded by mmap'ing
+ * the append-only history file (no line-by-line parsing on startup),
+ * and new entries are appended to the file as they are accepted.
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+/** Maximum number of history entries kept in memory */
+#define HISTORY_MAX_ENTRIES 10000
+
+/**
+ * @brief Initialize the history subsystem
+ *
+ * Opens (creating if needed) the history file at ~/.cshell_history
+ * and maps its contents into memory. Entry pointers reference the
+ * private mapping directly, so loading a large history does not copy
+ * or allocate per line.
+ *
+ * Runs lazily on the first history operation; an explicit call is
+ * only needed to control when the load happens. Idempotent until
+ * history_cleanup().
+ *
+ * @return int 0 on success, non-zero on error
+ */
+int history_init(void);
+
+/**
+ * @brief Clean up the history subsystem
+ *
+ * Unmaps the history file, frees session entries, and closes the
+ * append descriptor.
+ */
+void history_cleanup(void);
+
+/**
+ * @brief Add a line to history
+ *
+ * Appends the line to the in-memory ring and to the history file.
+ * Empty lines and immediate duplicates are skipped.
+ *
+ * @param line Command line to record
+ * @return int 0 on success, non-zero on error
+ */
+int history_add(const char *line);
+
+/**
+ * @brief Get the number of history entries
+ *
+ * @return int Number of entries currently held in memory
+ */
+int history_count(void);
+
+/**
+ * @brief Get a history entry
+ *
+ * @param index Entry index: 0 is the oldest, history_count()-1 the newest
+ * @return const char* Entry text (owned by the history subsystem), NULL if out of range
+ */
+const char *history_get(int index);
+
+#endif /* HISTORY_H */
@@ -0,0 +1,121 @@
+/**
+ * @file jobs.h
+ * @brief Background job control component
+ *
+ * Job table, SIGCHLD-driven reaping, and the primitives behind the
+ * jobs/fg/wait builtins.
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <sys/types.h>
+
+/** Maximum number of concurrent background jobs */
+#define MAX_JOBS 64
+
+/**
+ * @brief Job state
+ */
+typedef enum {
+    JOB_FREE = 0,    /**< Table slot is unused */
+    JOB_RUNNING,     /**< Job is still running */
+    JOB_DONE         /**< Job has exited, not yet reported */
+} JobState;
+
+/**
+ * @brief Background job entry
+ */
+typedef struct {
+    int id;          /**< Job number as shown by the jobs builtin */
+    pid_t pid;       /**< Process ID */
+    JobState state;  /**< Current state */
+    int status;      /**< Exit status (valid once JOB_DONE) */
+    char *cmdline;   /**< Command line as typed (owned by the table) */
+} Job;
+
+/**
+ * @brief Initialize job control
+ *
+ * Installs the SIGCHLD handler that reaps background children
+ * asynchronously - no polling from the shell loop.
+ *
+ * @return int 0 on success, non-zero on error
+ */
+int jobs_init(void);
+
+/**
+ * @brief Add a job to the table
+ *
+ * Records a freshly launched background process.
+ *
+ * @param pid Process ID of the job
+ * @param cmdline Command line as typed (copied)
+ * @return int Job number, or -1 if the table is full
+ */
+int job_add(pid_t pid, const char *cmdline);
+
+/**
+ * @brief Block SIGCHLD delivery
+ *
+ * Must bracket every foreground waitpid() so the handler cannot
+ * steal the foreground child's exit status.
+ */
+void jobs_block_sigchld(void);
+
+/**
+ * @brief Unblock SIGCHLD delivery
+ */
+void jobs_unblock_sigchld(void);
+
+/**
+ * @brief Reset the signal mask in a forked child
+ *
+ * The executor forks with SIGCHLD blocked; a child must not carry
+ * that block across exec. Called between fork() and exec to give the
+ * child an empty mask.
+ */
+void jobs_reset_child_sigmask(void);
+
+/**
+ * @brief Report finished background jobs
+ *
+ * Prints a "[n] Done" line for every job the handler has reaped
+ * since the last call, and releases their table slots. Called from
+ * the shell loop before each prompt.
+ */
+void jobs_report_finished(void);
+
+/**
+ * @brief Print the job table
+ *
+ * Lists all running and finished jobs (the jobs builtin).
+ */
+void jobs_print(void);
+
+/**
+ * @brief Wait for one job to finish
+ *
+ * Sleeps in sigsuspend() until the SIGCHLD handler marks the job
+ * done - no busy waiting. Releases the job's table slot.
+ *
+ * @param id Job number, or 0 for the most recent job
+ * @return int Exit status of the job, -1 if no such job
+ */
+int job_wait(int id);
+
+/**
+ * @brief Wait for all background jobs to finish
+ *
+ * @return int 0 on success
+ */
+int jobs_wait_all(void);
+
+/**
+ * @brief Release the job table
+ *
+ * Frees all stored command lines. Called at shell exit.
+ */
+void jobs_cleanup(void);
+
+#endif /* JOBS_H */
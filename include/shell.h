@@ -26,6 +26,7 @@
 #include "builtins/builtins.h"
 #include "terminal/terminal.h"
 #include "completion/completion.h"
+#include "utils/error.h"
 #include "utils/utils.h"
 
 /**
@@ -35,17 +36,10 @@
 #define SHELL_NAME "C-Shell"
 
 /**
- * @brief Error codes
- */
-#define SUCCESS 0
-#define ERR_GENERAL -1
-#define ERR_MEMORY -2
-#define ERR_SYNTAX -3
-#define ERR_IO -4
-#define ERR_COMMAND_NOT_FOUND -5
-
-/**
- * @brief Maximum input buffer size
+ * @brief Initial input buffer size
+ *
+ * Starting allocation for the line editor's buffer; the buffer grows
+ * as needed, so this is not a limit on input length.
  */
 #define INPUT_BUFFER_SIZE 1024
 
@@ -19,6 +19,7 @@ enum KeyCode {
     KEY_CTRL_D = 4,    /**< Ctrl+D (EOF) */
     KEY_CTRL_E = 5,    /**< Ctrl+E (End) */
     KEY_CTRL_F = 6,    /**< Ctrl+F (Right) */
+    KEY_CTRL_G = 7,    /**< Ctrl+G (Abort search) */
     KEY_CTRL_H = 8,    /**< Ctrl+H (Backspace) */
     KEY_TAB = 9,       /**< Tab */
     KEY_CTRL_K = 11,   /**< Ctrl+K (Kill to end) */
@@ -26,6 +27,7 @@ enum KeyCode {
     KEY_ENTER = 13,    /**< Enter */
     KEY_CTRL_N = 14,   /**< Ctrl+N (Next history) */
     KEY_CTRL_P = 16,   /**< Ctrl+P (Previous history) */
+    KEY_CTRL_R = 18,   /**< Ctrl+R (Reverse history search) */
     KEY_CTRL_T = 20,   /**< Ctrl+T (Transpose chars) */
     KEY_CTRL_U = 21,   /**< Ctrl+U (Kill to beginning) */
     KEY_CTRL_W = 23,   /**< Ctrl+W (Kill word) */
@@ -45,7 +47,9 @@ enum EscapeSequence {
     SEQ_END,           /**< End key */
     SEQ_DELETE,        /**< Delete key */
     SEQ_PAGE_UP,       /**< Page Up */
-    SEQ_PAGE_DOWN      /**< Page Down */
+    SEQ_PAGE_DOWN,     /**< Page Down */
+    SEQ_PASTE_START,   /**< Bracketed paste start (ESC[200~) */
+    SEQ_PASTE_END      /**< Bracketed paste end (ESC[201~) */
 };
 
 /**
@@ -76,12 +80,24 @@ void line_state_cleanup(LineState *ls);
 
 /**
  * @brief Read a line with editing capabilities
- * 
+ *
  * @param ls LineState structure
  * @return int Characters read or -1 on error
  */
 int read_edited_line(LineState *ls);
 
+/**
+ * @brief Replace the line buffer contents
+ *
+ * Replaces the edited line with the given text and moves the cursor
+ * to the end, growing the buffer if needed.
+ *
+ * @param ls LineState structure
+ * @param text New line contents
+ * @return int 0 on success, non-zero on error
+ */
+int line_state_set(LineState *ls, const char *text);
+
 /**
  * @brief Insert character at cursor
  * 
@@ -91,6 +107,19 @@ int read_edited_line(LineState *ls);
  */
 int insert_char(LineState *ls, char c);
 
+/**
+ * @brief Insert a block of text at cursor
+ *
+ * Inserts n bytes in one operation: one capacity check, one memmove
+ * of the tail, one copy. Used for pastes.
+ *
+ * @param ls LineState structure
+ * @param text Bytes to insert
+ * @param n Number of bytes
+ * @return int 0 on success, non-zero on error
+ */
+int insert_text(LineState *ls, const char *text, int n);
+
 /**
  * @brief Delete character at cursor
  * 
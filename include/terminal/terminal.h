@@ -42,23 +42,45 @@ void disable_raw_mode(void);
 
 /**
  * @brief Read a character from terminal
- * 
- * Reads a single character from the terminal.
- * 
+ *
+ * Reads a single character through the input buffer. The underlying
+ * read(2) pulls in whatever is available, so rapid typing and pastes
+ * cost a handful of syscalls instead of one per byte.
+ *
  * @return int Character read, or -1 on error
  */
 int read_char(void);
 
+/**
+ * @brief Peek at the next buffered character
+ *
+ * Returns the next character without consuming it. Only looks at the
+ * userspace buffer - never blocks or issues a read(2).
+ *
+ * @return int Next character, or -1 if the buffer is empty
+ */
+int peek_char(void);
+
+/**
+ * @brief Check whether input is pending
+ *
+ * Returns non-zero if a character can be read without blocking,
+ * either from the input buffer or from the terminal itself.
+ *
+ * @return int 1 if input is pending, 0 otherwise
+ */
+int input_pending(void);
+
 /**
  * @brief Read a line from terminal
- * 
- * Reads a line of input with editing capabilities.
- * 
- * @param buffer Buffer to store the input
- * @param size Buffer size
- * @return int Number of characters read, or -1 on error
+ *
+ * Reads a line of input with editing capabilities. The line comes
+ * back in the editor's own heap buffer, so it can be arbitrarily
+ * long - there is no fixed-size truncation on the input path.
+ *
+ * @return char* The line read (caller must free), NULL on EOF or error
  */
-int read_line(char *buffer, int size);
+char *read_line(void);
 
 /**
  * @brief Clear the screen
@@ -102,6 +124,23 @@ int get_terminal_size(int *rows, int *cols);
  */
 void refresh_line(const char *buffer, int cursor);
 
+/**
+ * @brief Invalidate the tracked line state
+ *
+ * Forces the next refresh_line() to do a full repaint. Call after
+ * writing to the terminal outside the renderer (completion lists,
+ * search prompts, command output).
+ */
+void refresh_line_invalidate(void);
+
+/**
+ * @brief Invalidate the cached prompt
+ *
+ * Forces the next display_prompt() to re-read the working directory.
+ * Called when the cd builtin actually changes directory.
+ */
+void prompt_invalidate(void);
+
 /**
  * @brief Set input processing mode
  * 
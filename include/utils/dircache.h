@@ -0,0 +1,40 @@
+/**
+ * @file dircache.h
+ * @brief Cached directory listings
+ *
+ * A small cache of directory listings (path -> sorted entries),
+ * invalidated by the directory's modification time. Shared by glob
+ * expansion in the parser and the tab-completion scanner, so repeated
+ * lookups in the same directory read it from disk once.
+ */
+
+#ifndef DIRCACHE_H
+#define DIRCACHE_H
+
+/**
+ * @brief One cached directory entry
+ */
+typedef struct {
+    char *name;    /**< Entry name (cache-owned) */
+    int is_dir;    /**< 1 if the entry is a directory */
+} DirCacheEntry;
+
+/**
+ * @brief Get the sorted listing of a directory
+ *
+ * Returns the cached listing when the directory's mtime is unchanged,
+ * otherwise rescans it. The returned array is owned by the cache and
+ * valid until the next dir_cache_get() call or dir_cache_destroy().
+ *
+ * @param path Directory path
+ * @param count Out: number of entries
+ * @return const DirCacheEntry* Sorted entries, NULL if unreadable
+ */
+const DirCacheEntry *dir_cache_get(const char *path, int *count);
+
+/**
+ * @brief Release all cached listings
+ */
+void dir_cache_destroy(void);
+
+#endif /* DIRCACHE_H */
@@ -0,0 +1,62 @@
+/**
+ * @file dirjump.h
+ * @brief Frecency-ranked directory jump index
+ *
+ * Every successful cd records its target directory into a small
+ * frecency (frequency + recency) index. When cd is given a name that
+ * does not resolve on disk, the index answers with the best-ranked
+ * directory matching it - no filesystem walking. The index persists
+ * in a compact binary file in $HOME, loaded at shell_init().
+ */
+
+#ifndef DIRJUMP_H
+#define DIRJUMP_H
+
+/** Maximum directories tracked; the lowest-scored entry is evicted */
+#define DIRJUMP_MAX_ENTRIES 512
+
+/**
+ * @brief Initialize the jump index
+ *
+ * Loads the persisted index from $HOME. Without $HOME the index is
+ * session-only, matching history behaviour.
+ *
+ * Runs lazily on the first record or resolve; an explicit call is
+ * only needed to control when the load happens. Idempotent until
+ * dirjump_cleanup().
+ *
+ * @return int 0 on success, non-zero on error
+ */
+int dirjump_init(void);
+
+/**
+ * @brief Clean up the jump index
+ *
+ * Writes the index back to disk when it changed, then releases it.
+ */
+void dirjump_cleanup(void);
+
+/**
+ * @brief Record a visit to a directory
+ *
+ * Bumps the directory's visit count and recency stamp, adding it to
+ * the index if new. Non-absolute paths are ignored.
+ *
+ * @param path Absolute path of the visited directory
+ */
+void dirjump_record(const char *path);
+
+/**
+ * @brief Resolve a name against the jump index
+ *
+ * Returns the highest-frecency directory whose path contains the
+ * query, preferring matches in the final path component. Entries
+ * whose directories no longer exist are pruned as they are met.
+ *
+ * @param query Name to resolve
+ * @return const char* Best matching path (owned by the index), NULL
+ *         if nothing matches
+ */
+const char *dirjump_resolve(const char *query);
+
+#endif /* DIRJUMP_H */
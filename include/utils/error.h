@@ -9,6 +9,7 @@
 #define ERROR_H
 
 #include <stdarg.h>
+#include <stdio.h>
 
 /**
  * @brief Error levels
@@ -125,11 +126,42 @@ void error_debug(const char *file, int line, const char *func,
  */
 const char *error_message(ErrorCode code);
 
+/**
+ * @brief Check whether the deferred log channel is enabled
+ *
+ * Reads CSHELL_ASYNC_LOG once and caches the answer. When enabled,
+ * non-fatal reports deposit a compact record into a fixed ring with
+ * one atomic slot claim instead of writing to stderr inline; the
+ * ring is drained at idle, at exit, and by the log builtin.
+ * Disabled by default - errors print synchronously as always.
+ *
+ * @return int 1 if deferred logging is enabled, 0 otherwise
+ */
+int error_log_async(void);
+
+/**
+ * @brief Check for undrained log records
+ *
+ * @return int 1 if records are waiting, 0 otherwise
+ */
+int error_log_pending(void);
+
+/**
+ * @brief Format and emit all pending log records
+ *
+ * Runs off the hot path; strerror() resolution for deferred system
+ * errors happens here. If the ring wrapped before draining, the
+ * number of overwritten records is reported first.
+ *
+ * @param fp Output stream
+ */
+void error_log_drain(FILE *fp);
+
 /**
  * @brief Set error handler
- * 
+ *
  * Sets a custom error handler function.
- * 
+ *
  * @param handler Error handler function
  */
 void error_set_handler(void (*handler)(ErrorLevel level, ErrorCode code, 
@@ -0,0 +1,144 @@
+/**
+ * @file memory.h
+ * @brief Memory management utilities
+ *
+ * Functions for memory allocation with error checking.
+ */
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief Safe malloc
+ *
+ * Allocates memory with error checking.
+ *
+ * @param size Size to allocate
+ * @return void* Allocated memory
+ */
+void *safe_malloc(size_t size);
+
+/**
+ * @brief Safe calloc
+ *
+ * Allocates and zeroes memory with error checking.
+ *
+ * @param nmemb Number of elements
+ * @param size Size of each element
+ * @return void* Allocated memory
+ */
+void *safe_calloc(size_t nmemb, size_t size);
+
+/**
+ * @brief Safe realloc
+ *
+ * Reallocates memory with error checking.
+ *
+ * @param ptr Pointer to reallocate
+ * @param size New size
+ * @return void* Reallocated memory
+ */
+void *safe_realloc(void *ptr, size_t size);
+
+/**
+ * @brief Safe free
+ *
+ * Frees memory and sets pointer to NULL.
+ *
+ * @param pptr Pointer to pointer to free
+ */
+void safe_free(void **pptr);
+
+/**
+ * @brief Duplicate memory block
+ *
+ * Duplicates a memory block.
+ *
+ * @param src Source pointer
+ * @param size Size to duplicate
+ * @return void* Duplicated memory
+ */
+void *mem_dup(const void *src, size_t size);
+
+/**
+ * @brief Allocate memory for string of specified length
+ *
+ * @param len String length (not including null terminator)
+ * @return char* Allocated memory
+ */
+char *str_alloc(size_t len);
+
+/**
+ * @brief Debug memory allocation
+ *
+ * Allocates memory with debugging information.
+ *
+ * @param size Size to allocate
+ * @param file Source file
+ * @param line Line number
+ * @return void* Allocated memory
+ */
+void *debug_malloc(size_t size, const char *file, int line);
+
+/**
+ * @brief Print memory statistics
+ *
+ * Prints memory allocation statistics (debug build only).
+ */
+void print_memory_stats(void);
+
+/**
+ * @brief Allocate from the command arena
+ *
+ * Bump-allocates from the per-command arena. Arena memory is never
+ * freed individually - the whole arena is recycled by arena_reset()
+ * at the end of each processed command. Do not free() the result.
+ *
+ * @param size Size to allocate
+ * @return void* Allocated memory, NULL on failure
+ */
+void *arena_alloc(size_t size);
+
+/**
+ * @brief Duplicate a string into the command arena
+ *
+ * Like strdup(), but the copy lives in the command arena and must
+ * not be free()d; it is reclaimed by arena_reset().
+ *
+ * @param str String to duplicate
+ * @return char* Arena-allocated copy, NULL on failure
+ */
+char *arena_strdup(const char *str);
+
+/**
+ * @brief Reset the command arena
+ *
+ * Reclaims all arena allocations in O(1): the first block is kept
+ * for reuse and any overflow blocks are returned to the system.
+ * Called once per command, after execution completes.
+ */
+void arena_reset(void);
+
+/**
+ * @brief Destroy the command arena
+ *
+ * Frees all arena blocks, including the resident first block.
+ * Called on shell shutdown.
+ */
+void arena_destroy(void);
+
+/**
+ * @brief Dump arena pool statistics
+ *
+ * Reports allocation counts, block-malloc misses, the resulting
+ * pool hit rate, and the peak per-command footprint. Available in
+ * release builds.
+ *
+ * @param fp Output stream
+ */
+void arena_stats_dump(FILE *fp);
+
+#endif /* MEMORY_H */
@@ -0,0 +1,67 @@
+/**
+ * @file output.h
+ * @brief Buffered builtin output writer
+ *
+ * A shell-owned output buffer for builtins and the completion match
+ * printer. Writes accumulate in a grow-in-place buffer and reach the
+ * terminal (or the redirection target - builtins run after their
+ * redirections are dup2'd onto stdout, so the buffer lands wherever
+ * fd 1 points) as a single write(2) at the flush point, instead of
+ * one syscall-sized write per printf through stdio.
+ *
+ * Flush points: the end of each builtin command, before anything
+ * that waits for input, and before the shell exits.
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+
+/**
+ * @brief Append bytes to the output buffer
+ *
+ * @param data Bytes to append
+ * @param len Number of bytes
+ * @return int 0 on success, non-zero on error
+ */
+int out_write(const char *data, size_t len);
+
+/**
+ * @brief Append one character to the output buffer
+ *
+ * @param c Character to append
+ * @return int 0 on success, non-zero on error
+ */
+int out_putc(char c);
+
+/**
+ * @brief Append formatted text to the output buffer
+ *
+ * printf-style formatting straight into the buffer's spare space -
+ * no intermediate copy.
+ *
+ * @param format Format string
+ * @param ... Format arguments
+ * @return int 0 on success, non-zero on error
+ */
+int out_printf(const char *format, ...);
+
+/**
+ * @brief Write the buffered output to stdout
+ *
+ * Flushes stdio's stdout first so output written with plain printf
+ * keeps its place, then empties the buffer with one write(2) to
+ * fd 1. A no-op when the buffer is empty. The buffer keeps its
+ * allocation for the next command.
+ *
+ * @return int 0 on success, non-zero if the write failed
+ */
+int out_flush(void);
+
+/**
+ * @brief Flush and release the output buffer
+ */
+void out_destroy(void);
+
+#endif /* OUTPUT_H */
@@ -0,0 +1,169 @@
+/**
+ * @file path.h
+ * @brief Path manipulation utilities
+ *
+ * Functions for path manipulation and filesystem queries.
+ */
+
+#ifndef PATH_H
+#define PATH_H
+
+/**
+ * @brief Get directory name
+ *
+ * Extracts the directory part of a path.
+ *
+ * @param path Path to process
+ * @return char* Directory part (caller must free)
+ */
+char *path_dirname(const char *path);
+
+/**
+ * @brief Get base name
+ *
+ * Extracts the file name part of a path.
+ *
+ * @param path Path to process
+ * @return char* File name part (caller must free)
+ */
+char *path_basename(const char *path);
+
+/**
+ * @brief Join path components
+ *
+ * Joins two path components with appropriate separators.
+ *
+ * @param path1 First path component
+ * @param path2 Second path component
+ * @return char* Joined path (caller must free)
+ */
+char *path_join(const char *path1, const char *path2);
+
+/**
+ * @brief Normalize path
+ *
+ * Normalizes a path (resolves ., .., and duplicate separators).
+ *
+ * @param path Path to normalize
+ * @return char* Normalized path (caller must free)
+ */
+char *path_normalize(const char *path);
+
+/**
+ * @brief Get absolute path
+ *
+ * Converts a relative path to absolute path.
+ *
+ * @param path Path to convert
+ * @return char* Absolute path (caller must free)
+ */
+char *path_absolute(const char *path);
+
+/**
+ * @brief Check if path is absolute
+ *
+ * @param path Path to check
+ * @return int 1 if absolute, 0 if relative
+ */
+int path_is_absolute(const char *path);
+
+/**
+ * @brief Expand path
+ *
+ * Expands special characters (e.g., ~) in a path.
+ *
+ * @param path Path to expand
+ * @return char* Expanded path (caller must free)
+ */
+char *path_expand(const char *path);
+
+/**
+ * @brief Get file extension
+ *
+ * Extracts the file extension from a path.
+ *
+ * @param path Path to process
+ * @return char* File extension (caller must free)
+ */
+char *path_extension(const char *path);
+
+/**
+ * @brief Check if path exists
+ *
+ * @param path Path to check
+ * @return int 1 if exists, 0 otherwise
+ */
+int path_exists(const char *path);
+
+/**
+ * @brief Check if path is a directory
+ *
+ * @param path Path to check
+ * @return int 1 if directory, 0 otherwise
+ */
+int path_is_directory(const char *path);
+
+/**
+ * @brief Check if path is a regular file
+ *
+ * @param path Path to check
+ * @return int 1 if regular file, 0 otherwise
+ */
+int path_is_file(const char *path);
+
+/**
+ * @brief Check if path is executable
+ *
+ * @param path Path to check
+ * @return int 1 if executable, 0 otherwise
+ */
+int path_is_executable(const char *path);
+
+/**
+ * @brief Get parent directory
+ *
+ * Gets the parent directory of a path.
+ *
+ * @param path Path to process
+ * @return char* Parent directory (caller must free)
+ */
+char *path_parent(const char *path);
+
+/**
+ * @brief Search for file in PATH
+ *
+ * Searches for a file in the directories specified by PATH.
+ *
+ * @param filename File name to search for
+ * @return char* Full path if found (caller must free), NULL otherwise
+ */
+char *path_search(const char *filename);
+
+/**
+ * @brief Search for file in PATH using the executable cache
+ *
+ * Like path_search(), but answers from an in-memory index of
+ * executable name to resolved path. Cache entries are invalidated
+ * when $PATH changes or a PATH directory's mtime changes, and
+ * lookups that found nothing are remembered in a negative cache so
+ * repeated misses do not re-walk every PATH directory.
+ *
+ * Results are interned strings: they stay valid for the life of the
+ * shell and must not be freed. Passing an interned name (argv[0] is
+ * interned by the parser) reduces the key comparison to a pointer
+ * check.
+ *
+ * @param filename File name to search for
+ * @return const char* Interned full path if found (do not free), NULL otherwise
+ */
+const char *path_search_cached(const char *filename);
+
+/**
+ * @brief Clear the executable cache
+ *
+ * Drops all cached PATH lookup results. The cache is rebuilt lazily
+ * on the next path_search_cached() call.
+ */
+void path_cache_clear(void);
+
+#endif /* PATH_H */
@@ -202,4 +202,106 @@ int str_casecmp(const char *s1, const char *s2);
  */
 int str_ncasecmp(const char *s1, const char *s2, size_t n);
 
+/**
+ * @brief Growable string builder
+ *
+ * Accumulates characters with amortized-doubling growth, so callers
+ * never truncate and never pay a per-character realloc. The data
+ * pointer is always NUL-terminated.
+ */
+typedef struct {
+    char *data;        /**< Built string (always NUL-terminated) */
+    size_t length;     /**< Current length (excluding the NUL) */
+    size_t capacity;   /**< Allocated bytes */
+} StrBuilder;
+
+/**
+ * @brief Initialize a string builder
+ *
+ * @param sb Builder to initialize
+ * @param initial_capacity Initial allocation (0 for the default)
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_init(StrBuilder *sb, size_t initial_capacity);
+
+/**
+ * @brief Append one character
+ *
+ * @param sb Builder to append to
+ * @param c Character to append
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_append_char(StrBuilder *sb, char c);
+
+/**
+ * @brief Append a counted byte range
+ *
+ * @param sb Builder to append to
+ * @param str Bytes to append
+ * @param n Number of bytes
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_append_n(StrBuilder *sb, const char *str, size_t n);
+
+/**
+ * @brief Append a NUL-terminated string
+ *
+ * @param sb Builder to append to
+ * @param str String to append
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_append(StrBuilder *sb, const char *str);
+
+/**
+ * @brief Reset a builder to empty without releasing its buffer
+ *
+ * @param sb Builder to clear
+ */
+void str_builder_clear(StrBuilder *sb);
+
+/**
+ * @brief Take ownership of the built string
+ *
+ * Returns the buffer and leaves the builder empty and unallocated.
+ *
+ * @param sb Builder to detach from
+ * @return char* Built string (caller must free), NULL if empty builder
+ */
+char *str_builder_detach(StrBuilder *sb);
+
+/**
+ * @brief Release a builder's buffer
+ *
+ * @param sb Builder to free
+ */
+void str_builder_free(StrBuilder *sb);
+
+/**
+ * @brief Intern a string
+ *
+ * Returns the canonical copy of the given bytes: every call with
+ * equal contents returns the same pointer, so interned strings can
+ * be compared (and hashed) by identity. Storage is an append-only
+ * chunk list behind a hash table; interned strings live until
+ * str_intern_destroy() and must never be freed or modified by the
+ * caller.
+ *
+ * Used for command names and resolved executable paths, where a
+ * long batch run repeats the same few strings millions of times.
+ *
+ * @param str Bytes to intern (need not be NUL-terminated)
+ * @param len Number of bytes
+ * @return const char* Canonical NUL-terminated copy, NULL on allocation failure
+ */
+const char *str_intern(const char *str, size_t len);
+
+/**
+ * @brief Release the intern pool
+ *
+ * Frees all interned strings. Callers holding interned pointers
+ * (the executable cache, the alias table) must be torn down or done
+ * with them first.
+ */
+void str_intern_destroy(void);
+
 #endif /* STRING_UTILS_H */
\ No newline at end of file
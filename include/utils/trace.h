@@ -0,0 +1,110 @@
+/**
+ * @file trace.h
+ * @brief Hot-path latency tracing
+ *
+ * Lightweight span instrumentation for the command-processing and
+ * completion paths. Spans are accumulated into per-stage log2
+ * histograms in memory; nothing is written while tracing. Disabled
+ * by default - set CSHELL_TRACE=1 to enable. Results are printed by
+ * the stats builtin and dumped at shell exit.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <sys/resource.h>
+
+/**
+ * @brief Instrumented stages
+ */
+typedef enum {
+    TRACE_PARSE_CHAIN,     /**< Chain operator splitting */
+    TRACE_TOKENIZE,        /**< Single-pass command tokenizer */
+    TRACE_BUILTIN_LOOKUP,  /**< find_builtin() dispatch */
+    TRACE_BUILTIN_RUN,     /**< Builtin execution */
+    TRACE_SPAWN,           /**< Child process launch */
+    TRACE_WAIT,            /**< Foreground waitpid() */
+    TRACE_PIPELINE,        /**< Whole pipeline execution */
+    TRACE_COMPLETION,      /**< Tab completion handling */
+    TRACE_STAGE_COUNT      /**< Number of stages */
+} TraceStage;
+
+/**
+ * @brief Check whether tracing is enabled
+ *
+ * Reads CSHELL_TRACE once and caches the answer, so the disabled
+ * path costs one branch per span.
+ *
+ * @return int 1 if tracing is enabled, 0 otherwise
+ */
+int trace_enabled(void);
+
+/**
+ * @brief Start a span
+ *
+ * @return long Start timestamp in ns, or 0 when tracing is disabled
+ */
+long trace_begin(void);
+
+/**
+ * @brief End a span and record it
+ *
+ * No-op when start is 0 (tracing disabled at trace_begin time).
+ *
+ * @param stage Stage the span belongs to
+ * @param start Timestamp returned by trace_begin()
+ */
+void trace_end(TraceStage stage, long start);
+
+/**
+ * @brief Dump all stage histograms
+ *
+ * Prints count, mean, approximate p50/p99, max, and the populated
+ * latency buckets for every stage that recorded at least one span.
+ *
+ * @param fp Output stream
+ */
+void trace_dump(FILE *fp);
+
+/**
+ * @brief Reset all histograms
+ */
+void trace_reset(void);
+
+/**
+ * @brief Check whether per-command resource recording is enabled
+ *
+ * Reads CSHELL_RUSAGE once and caches the answer. Disabled by
+ * default; the data is collected at the foreground wait either way,
+ * so enabling it only adds the bookkeeping below.
+ *
+ * @return int 1 if recording is enabled, 0 otherwise
+ */
+int rusage_enabled(void);
+
+/**
+ * @brief Record one foreground command's resource usage
+ *
+ * Takes RUSAGE_CHILDREN snapshots from before and after the wait and
+ * folds the delta into the running totals. No-op unless recording is
+ * enabled.
+ *
+ * @param before Children rusage before the command was launched
+ * @param after Children rusage after the command was reaped
+ * @param wall_ns Wall-clock duration of the command in ns
+ */
+void trace_record_rusage(const struct rusage *before,
+                         const struct rusage *after, long wall_ns);
+
+/**
+ * @brief Dump accumulated per-command resource usage
+ *
+ * Prints command count, total wall/user/sys time, fault totals, and
+ * the peak child max-RSS seen.
+ *
+ * @param fp Output stream
+ */
+void trace_rusage_dump(FILE *fp);
+
+#endif /* TRACE_H */
@@ -6,27 +6,80 @@
  */
 
 #include "builtins/builtins.h"
+#include "command/alias.h"
 #include "command/command.h"
+#include "jobs/jobs.h"
+#include "terminal/terminal.h"
+#include "utils/dirjump.h"
 #include "utils/error.h"
+#include "utils/memory.h"
+#include "utils/output.h"
+#include "utils/trace.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 // Table of built-in commands
 static const BuiltinCommand builtin_commands[] = {
+    { "[",      builtin_test,   "Evaluate a conditional expression" },
+    { "alias",  builtin_alias,  "Define or display command aliases" },
     { "cd",     builtin_cd,     "Change the current directory" },
     { "echo",   builtin_echo,   "Display a line of text" },
     { "exit",   builtin_exit,   "Exit the shell" },
+    { "false",  builtin_false,  "Return an unsuccessful status" },
+    { "fg",     builtin_fg,     "Wait for a background job in the foreground" },
+    { "jobs",   builtin_jobs,   "List background jobs" },
+    { "log",    builtin_log,    "Dump the deferred error log" },
+    { "printf", builtin_printf, "Format and print arguments" },
     { "pwd",    builtin_pwd,    "Print the current working directory" },
+    { "stats",  builtin_stats,  "Show hot-path latency histograms" },
+    { "test",   builtin_test,   "Evaluate a conditional expression" },
+    { "time",   builtin_time,   "Time a command and report resource usage" },
+    { "true",   builtin_true,   "Return a successful status" },
     { "type",   builtin_type,   "Display information about command type" },
+    { "unalias", builtin_unalias, "Remove command aliases" },
+    { "wait",   builtin_wait,   "Wait for background jobs to finish" },
     { "help",   builtin_help,   "Display help for built-in commands" },
     { NULL,     NULL,           NULL }  // End of array marker
 };
 
+/** Number of entries in builtin_commands (excluding the terminator) */
+#define NUM_BUILTINS ((int)(sizeof(builtin_commands) / sizeof(builtin_commands[0])) - 1)
+
+// First-character dispatch index: bucket_head[c] is the first table
+// entry whose name starts with c, bucket_next chains the rest. Built
+// once, then lookup touches only names sharing the first character.
+static signed char bucket_head[256];
+static signed char bucket_next[NUM_BUILTINS];
+static unsigned char name_lengths[NUM_BUILTINS];
+static int dispatch_index_built = 0;
+
+/**
+ * @brief Build the first-character dispatch index
+ *
+ * One linear pass over the table; runs once on the first lookup.
+ */
+static void build_dispatch_index(void) {
+    memset(bucket_head, -1, sizeof(bucket_head));
+
+    for (int i = 0; i < NUM_BUILTINS; i++) {
+        unsigned char c = (unsigned char)builtin_commands[i].name[0];
+        name_lengths[i] = (unsigned char)strlen(builtin_commands[i].name);
+        bucket_next[i] = bucket_head[c];
+        bucket_head[c] = (signed char)i;
+    }
+
+    dispatch_index_built = 1;
+}
+
 /**
  * @brief Get the table of built-in commands
- * 
+ *
  * @return const BuiltinCommand* Array of built-in commands (NULL-terminated)
  */
 const BuiltinCommand *get_builtin_commands(void) {
@@ -35,21 +88,33 @@ const BuiltinCommand *get_builtin_commands(void) {
 
 /**
  * @brief Find a built-in command by name
- * 
+ *
+ * Dispatches through the first-character index, so a lookup compares
+ * at most the handful of names sharing the command's first letter -
+ * and most misses (external commands) exit on an empty bucket without
+ * a single strcmp.
+ *
  * @param name Command name to search for
  * @return BuiltinFunc Function pointer for the command or NULL if not found
  */
 BuiltinFunc find_builtin(const char *name) {
-    if (!name) {
+    if (!name || name[0] == '\0') {
         return NULL;
     }
-    
-    for (int i = 0; builtin_commands[i].name != NULL; i++) {
-        if (strcmp(name, builtin_commands[i].name) == 0) {
+
+    if (!dispatch_index_built) {
+        build_dispatch_index();
+    }
+
+    size_t len = strlen(name);
+
+    for (int i = bucket_head[(unsigned char)name[0]]; i != -1; i = bucket_next[i]) {
+        if (name_lengths[i] == len &&
+            memcmp(name, builtin_commands[i].name, len) == 0) {
             return builtin_commands[i].func;
         }
     }
-    
+
     return NULL;
 }
 
@@ -88,6 +153,19 @@ int builtin_dispatch(Command *cmd) {
  * @param cmd Command structure
  * @return int Exit status
  */
+/**
+ * @brief Record the current directory in the jump index
+ *
+ * Called after every successful cd so the frecency index tracks
+ * where the session actually goes.
+ */
+static void cd_record_pwd(void) {
+    char cwd[PATH_MAX];
+    if (getcwd(cwd, sizeof(cwd)) != NULL) {
+        dirjump_record(cwd);
+    }
+}
+
 int builtin_cd(Command *cmd) {
     if (!cmd) {
         return -1;
@@ -133,18 +211,33 @@ int builtin_cd(Command *cmd) {
                 free(new_path);
                 return 1;
             }
-            
+
             free(new_path);
+            cd_record_pwd();
+            prompt_invalidate();
             return 0;
         }
     }
     
     // Change directory
     if (chdir(path) != 0) {
+        // No such directory here: a bare name can still resolve
+        // against the frecency jump index
+        if (path[0] != '/' && path[0] != '.' && path[0] != '~') {
+            const char *jump = dirjump_resolve(path);
+            if (jump && chdir(jump) == 0) {
+                out_printf("%s\n", jump);
+                cd_record_pwd();
+                prompt_invalidate();
+                return 0;
+            }
+        }
         fprintf(stderr, "cd: %s: No such file or directory\n", path);
         return 1;
     }
-    
+
+    cd_record_pwd();
+    prompt_invalidate();
     return 0;
 }
 
@@ -162,13 +255,13 @@ int builtin_echo(Command *cmd) {
     // Print each argument with a space between
     for (int i = 1; i < cmd->argc; i++) {
         if (i > 1) {
-            printf(" ");
+            out_putc(' ');
         }
-        printf("%s", cmd->argv[i]);
+        out_printf("%s", cmd->argv[i]);
     }
     
     // Print a newline
-    printf("\n");
+    out_putc('\n');
     
     return 0;
 }
@@ -198,6 +291,12 @@ int builtin_exit(Command *cmd) {
         }
     }
     
+    // This path bypasses shell_cleanup(), so persist the jump index
+    // and drain the output buffer here; everything else is reclaimed
+    // by process exit anyway
+    dirjump_cleanup();
+    out_flush();
+
     // Exit with the given status
     exit(status);
     
@@ -224,7 +323,7 @@ int builtin_pwd(Command *cmd) {
     }
     
     // Print current directory
-    printf("%s\n", cwd);
+    out_printf("%s\n", cwd);
     
     return 0;
 }
@@ -254,7 +353,7 @@ int builtin_type(Command *cmd) {
         
         // Check if it's a built-in command
         if (is_builtin(arg)) {
-            printf("%s is a shell builtin\n", arg);
+            out_printf("%s is a shell builtin\n", arg);
             continue;
         }
         
@@ -281,7 +380,7 @@ int builtin_type(Command *cmd) {
             snprintf(full_path, sizeof(full_path), "%s/%s", dir, arg);
             
             if (access(full_path, X_OK) == 0) {
-                printf("%s is %s\n", arg, full_path);
+                out_printf("%s is %s\n", arg, full_path);
                 found = 1;
                 break;
             }
@@ -292,7 +391,7 @@ int builtin_type(Command *cmd) {
         free(path_copy);
         
         if (!found) {
-            printf("%s not found\n", arg);
+            out_printf("%s not found\n", arg);
             ret = 1;
         }
     }
@@ -300,9 +399,548 @@ int builtin_type(Command *cmd) {
     return ret;
 }
 
+/**
+ * @brief true built-in
+ *
+ * @param cmd Command structure
+ * @return int Always 0
+ */
+int builtin_true(Command *cmd) {
+    (void)cmd;
+    return 0;
+}
+
+/**
+ * @brief false built-in
+ *
+ * @param cmd Command structure
+ * @return int Always 1
+ */
+int builtin_false(Command *cmd) {
+    (void)cmd;
+    return 1;
+}
+
+/**
+ * @brief Alias built-in command
+ *
+ * With no arguments, prints all defined aliases. Each name=value
+ * argument defines (or redefines) an alias; a bare name prints that
+ * alias.
+ *
+ * @param cmd Command structure
+ * @return int 0 on success, 1 if a lookup failed
+ */
+int builtin_alias(Command *cmd) {
+    if (!cmd) {
+        return 1;
+    }
+
+    if (cmd->argc == 1) {
+        alias_print();
+        return 0;
+    }
+
+    int status = 0;
+    for (int i = 1; i < cmd->argc; i++) {
+        char *eq = strchr(cmd->argv[i], '=');
+        if (eq && eq != cmd->argv[i]) {
+            // Split name=value in place; argv lives in the arena
+            *eq = '\0';
+            if (alias_set(cmd->argv[i], eq + 1) != 0) {
+                status = 1;
+            }
+            *eq = '=';
+        } else {
+            const char *value = alias_get(cmd->argv[i]);
+            if (value) {
+                out_printf("alias %s='%s'\n", cmd->argv[i], value);
+            } else {
+                fprintf(stderr, "alias: %s: not found\n", cmd->argv[i]);
+                status = 1;
+            }
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Unalias built-in command
+ *
+ * Removes the named aliases; -a removes all of them.
+ *
+ * @param cmd Command structure
+ * @return int 0 on success, 1 on error
+ */
+int builtin_unalias(Command *cmd) {
+    if (!cmd || cmd->argc < 2) {
+        fprintf(stderr, "unalias: usage: unalias [-a] name ...\n");
+        return 1;
+    }
+
+    if (strcmp(cmd->argv[1], "-a") == 0) {
+        alias_cleanup();
+        return 0;
+    }
+
+    int status = 0;
+    for (int i = 1; i < cmd->argc; i++) {
+        if (alias_remove(cmd->argv[i]) != 0) {
+            fprintf(stderr, "unalias: %s: not found\n", cmd->argv[i]);
+            status = 1;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Evaluate a test expression
+ *
+ * Handles the common test(1) subset: unary file and string operators,
+ * string equality, integer comparisons, and '!' negation.
+ *
+ * @param argc Number of expression words
+ * @param argv Expression words
+ * @return int 0 if true, 1 if false, 2 on a malformed expression
+ */
+static int test_eval(int argc, char **argv) {
+    // '!' negates the rest of the expression
+    if (argc > 0 && strcmp(argv[0], "!") == 0) {
+        int result = test_eval(argc - 1, argv + 1);
+        if (result == 2) return 2;
+        return !result;
+    }
+
+    if (argc == 0) {
+        return 1;  // Empty expression is false
+    }
+
+    if (argc == 1) {
+        return argv[0][0] != '\0' ? 0 : 1;  // Non-empty string is true
+    }
+
+    if (argc == 2) {
+        const char *op = argv[0];
+        const char *arg = argv[1];
+        struct stat st;
+
+        if (strcmp(op, "-n") == 0) return arg[0] != '\0' ? 0 : 1;
+        if (strcmp(op, "-z") == 0) return arg[0] == '\0' ? 0 : 1;
+        if (strcmp(op, "-e") == 0) return access(arg, F_OK) == 0 ? 0 : 1;
+        if (strcmp(op, "-r") == 0) return access(arg, R_OK) == 0 ? 0 : 1;
+        if (strcmp(op, "-w") == 0) return access(arg, W_OK) == 0 ? 0 : 1;
+        if (strcmp(op, "-x") == 0) return access(arg, X_OK) == 0 ? 0 : 1;
+        if (strcmp(op, "-f") == 0)
+            return (stat(arg, &st) == 0 && S_ISREG(st.st_mode)) ? 0 : 1;
+        if (strcmp(op, "-d") == 0)
+            return (stat(arg, &st) == 0 && S_ISDIR(st.st_mode)) ? 0 : 1;
+        if (strcmp(op, "-s") == 0)
+            return (stat(arg, &st) == 0 && st.st_size > 0) ? 0 : 1;
+
+        fprintf(stderr, "test: %s: unary operator expected\n", op);
+        return 2;
+    }
+
+    if (argc == 3) {
+        const char *op = argv[1];
+
+        if (strcmp(op, "=") == 0 || strcmp(op, "==") == 0)
+            return strcmp(argv[0], argv[2]) == 0 ? 0 : 1;
+        if (strcmp(op, "!=") == 0)
+            return strcmp(argv[0], argv[2]) != 0 ? 0 : 1;
+
+        // Integer comparisons
+        if (op[0] == '-') {
+            char *end1, *end2;
+            long a = strtol(argv[0], &end1, 10);
+            long b = strtol(argv[2], &end2, 10);
+
+            if (*end1 != '\0' || *end2 != '\0') {
+                fprintf(stderr, "test: integer expression expected\n");
+                return 2;
+            }
+
+            if (strcmp(op, "-eq") == 0) return a == b ? 0 : 1;
+            if (strcmp(op, "-ne") == 0) return a != b ? 0 : 1;
+            if (strcmp(op, "-lt") == 0) return a <  b ? 0 : 1;
+            if (strcmp(op, "-le") == 0) return a <= b ? 0 : 1;
+            if (strcmp(op, "-gt") == 0) return a >  b ? 0 : 1;
+            if (strcmp(op, "-ge") == 0) return a >= b ? 0 : 1;
+        }
+
+        fprintf(stderr, "test: %s: binary operator expected\n", op);
+        return 2;
+    }
+
+    fprintf(stderr, "test: too many arguments\n");
+    return 2;
+}
+
+/**
+ * @brief test / [ built-in
+ *
+ * Evaluates a conditional expression in-process; the scripts that
+ * lean on test no longer fork /usr/bin/test per check.
+ *
+ * @param cmd Command structure
+ * @return int 0 if true, 1 if false, 2 on error
+ */
+int builtin_test(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    int argc = cmd->argc - 1;
+    char **argv = cmd->argv + 1;
+
+    // The '[' form requires a closing ']'
+    if (strcmp(cmd->argv[0], "[") == 0) {
+        if (argc == 0 || strcmp(argv[argc - 1], "]") != 0) {
+            fprintf(stderr, "[: missing ']'\n");
+            return 2;
+        }
+        argc--;
+    }
+
+    return test_eval(argc, argv);
+}
+
+/**
+ * @brief printf built-in
+ *
+ * Formats in-process with the common conversion subset (%s, %c,
+ * integer and floating conversions, flags and widths) and the usual
+ * backslash escapes. Missing arguments format as empty/zero.
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_printf(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    if (cmd->argc < 2) {
+        fprintf(stderr, "printf: usage: printf format [arguments]\n");
+        return 1;
+    }
+
+    const char *fmt = cmd->argv[1];
+    int argi = 2;
+
+    for (const char *p = fmt; *p != '\0'; p++) {
+        if (*p == '\\') {
+            // Backslash escapes
+            p++;
+            switch (*p) {
+                case 'n': out_putc('\n'); break;
+                case 't': out_putc('\t'); break;
+                case 'r': out_putc('\r'); break;
+                case 'a': out_putc('\a'); break;
+                case 'b': out_putc('\b'); break;
+                case 'f': out_putc('\f'); break;
+                case 'v': out_putc('\v'); break;
+                case '\\': out_putc('\\'); break;
+                case '0': out_putc('\0'); break;
+                case '\0': out_putc('\\'); p--; break;
+                default: out_putc('\\'); out_putc(*p); break;
+            }
+            continue;
+        }
+
+        if (*p != '%') {
+            out_putc(*p);
+            continue;
+        }
+
+        if (*(p + 1) == '%') {
+            out_putc('%');
+            p++;
+            continue;
+        }
+
+        // Copy the conversion spec (flags, width, precision) up to
+        // the conversion character, then hand it to printf with the
+        // right argument type
+        char spec[32];
+        int spec_len = 0;
+        spec[spec_len++] = '%';
+        p++;
+
+        while (*p != '\0' && strchr("-+ #0123456789.", *p) != NULL &&
+               spec_len < (int)sizeof(spec) - 3) {
+            spec[spec_len++] = *p++;
+        }
+
+        const char *arg = (argi < cmd->argc) ? cmd->argv[argi++] : "";
+        char conv = *p;
+
+        switch (conv) {
+            case 's':
+                spec[spec_len++] = 's';
+                spec[spec_len] = '\0';
+                out_printf(spec, arg);
+                break;
+            case 'c':
+                spec[spec_len++] = 'c';
+                spec[spec_len] = '\0';
+                out_printf(spec, arg[0] != '\0' ? arg[0] : ' ');
+                break;
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+                spec[spec_len++] = 'l';
+                spec[spec_len++] = (conv == 'i') ? 'd' : conv;
+                spec[spec_len] = '\0';
+                out_printf(spec, strtol(arg, NULL, 10));
+                break;
+            case 'f': case 'e': case 'g':
+                spec[spec_len++] = conv;
+                spec[spec_len] = '\0';
+                out_printf(spec, strtod(arg, NULL));
+                break;
+            case '\0':
+                fprintf(stderr, "printf: missing conversion character\n");
+                return 1;
+            default:
+                fprintf(stderr, "printf: %%%c: invalid conversion\n", conv);
+                return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief jobs (list background jobs) built-in
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_jobs(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    jobs_print();
+    return 0;
+}
+
+/**
+ * @brief fg (wait for a job in the foreground) built-in
+ *
+ * Accepts a job number ("fg 2" or "fg %2"); with no argument it
+ * waits for the most recent job.
+ *
+ * @param cmd Command structure
+ * @return int Exit status of the job
+ */
+int builtin_fg(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    int id = 0;  // Most recent job
+
+    if (cmd->argc > 1) {
+        const char *arg = cmd->argv[1];
+        if (arg[0] == '%') {
+            arg++;
+        }
+
+        char *endptr;
+        id = strtol(arg, &endptr, 10);
+        if (*endptr != '\0' || id <= 0) {
+            fprintf(stderr, "fg: %s: no such job\n", cmd->argv[1]);
+            return 1;
+        }
+    }
+
+    int status = job_wait(id);
+    if (status == -1) {
+        fprintf(stderr, "fg: %s: no such job\n",
+                cmd->argc > 1 ? cmd->argv[1] : "current");
+        return 1;
+    }
+
+    return status;
+}
+
+/**
+ * @brief wait built-in
+ *
+ * Waits for all background jobs, or for one job given its number.
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_wait(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    if (cmd->argc > 1) {
+        return builtin_fg(cmd);
+    }
+
+    jobs_wait_all();
+    return 0;
+}
+
+/**
+ * @brief stats (latency histograms) built-in
+ *
+ * Prints the per-stage latency histograms collected while
+ * CSHELL_TRACE=1. 'stats reset' clears them.
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_stats(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    if (cmd->argc > 1 && strcmp(cmd->argv[1], "reset") == 0) {
+        trace_reset();
+        return 0;
+    }
+
+    trace_dump(stdout);
+    trace_rusage_dump(stdout);
+    arena_stats_dump(stdout);
+    return 0;
+}
+
+/**
+ * @brief log built-in
+ *
+ * Dumps error records deferred while CSHELL_ASYNC_LOG=1.
+ *
+ * @param cmd Command structure
+ * @return int Exit status
+ */
+int builtin_log(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    if (!error_log_async()) {
+        out_printf("deferred logging disabled (set CSHELL_ASYNC_LOG=1 to enable)\n");
+        return 0;
+    }
+
+    if (!error_log_pending()) {
+        out_printf("(no pending log records)\n");
+        return 0;
+    }
+
+    error_log_drain(stdout);
+    return 0;
+}
+
+/**
+ * @brief Convert a timeval to microseconds
+ *
+ * @param tv Timeval to convert
+ * @return long Value in microseconds
+ */
+static long timeval_us(const struct timeval *tv) {
+    return tv->tv_sec * 1000000L + tv->tv_usec;
+}
+
+/**
+ * @brief Print one duration row in the classic time(1) style
+ *
+ * @param label Row label
+ * @param us Duration in microseconds
+ */
+static void print_time_row(const char *label, long us) {
+    long ms = us / 1000L;
+    fprintf(stderr, "%-7s %ldm%ld.%03lds\n",
+            label, ms / 60000L, (ms % 60000L) / 1000L, ms % 1000L);
+}
+
+/**
+ * @brief time built-in
+ *
+ * Runs the rest of the command line and reports wall, user, and
+ * system time, peak RSS, and page-fault counts on stderr. The data
+ * comes from getrusage() around the wait, so no extra process is
+ * forked the way wrapping in /usr/bin/time would. With no arguments,
+ * reports the shell's own accumulated usage.
+ *
+ * @param cmd Command structure
+ * @return int Exit status of the wrapped command
+ */
+int builtin_time(Command *cmd) {
+    if (!cmd) {
+        return -1;
+    }
+
+    if (cmd->argc < 2) {
+        struct rusage self;
+        if (getrusage(RUSAGE_SELF, &self) != 0) {
+            ERROR_SYSTEM(ERR_SYSTEM, "Failed to read resource usage");
+            return 1;
+        }
+        print_time_row("user", timeval_us(&self.ru_utime));
+        print_time_row("sys", timeval_us(&self.ru_stime));
+        fprintf(stderr, "%-7s %ld KB\n", "maxrss", self.ru_maxrss);
+        return 0;
+    }
+
+    // The wrapped command is everything after "time"; argv stays
+    // NULL-terminated because the slice shares the original array
+    Command sub = *cmd;
+    sub.argv = cmd->argv + 1;
+    sub.argc = cmd->argc - 1;
+
+    struct rusage self_before, child_before;
+    struct timespec wall_start, wall_end;
+    getrusage(RUSAGE_SELF, &self_before);
+    getrusage(RUSAGE_CHILDREN, &child_before);
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    int status;
+    BuiltinFunc builtin = find_builtin(sub.argv[0]);
+    if (builtin) {
+        status = builtin(&sub);
+    } else {
+        status = execute_external_command(&sub);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_end);
+    struct rusage self_after, child_after;
+    getrusage(RUSAGE_SELF, &self_after);
+    getrusage(RUSAGE_CHILDREN, &child_after);
+
+    long wall_us = (wall_end.tv_sec - wall_start.tv_sec) * 1000000L
+                 + (wall_end.tv_nsec - wall_start.tv_nsec) / 1000L;
+    long user_us = timeval_us(&self_after.ru_utime) - timeval_us(&self_before.ru_utime)
+                 + timeval_us(&child_after.ru_utime) - timeval_us(&child_before.ru_utime);
+    long sys_us = timeval_us(&self_after.ru_stime) - timeval_us(&self_before.ru_stime)
+                + timeval_us(&child_after.ru_stime) - timeval_us(&child_before.ru_stime);
+    long minflt = (self_after.ru_minflt - self_before.ru_minflt)
+                + (child_after.ru_minflt - child_before.ru_minflt);
+    long majflt = (self_after.ru_majflt - self_before.ru_majflt)
+                + (child_after.ru_majflt - child_before.ru_majflt);
+
+    // ru_maxrss is a high-water mark: the child figure is right for
+    // external commands, the shell's own for in-process builtins
+    long maxrss = builtin ? self_after.ru_maxrss : child_after.ru_maxrss;
+
+    fprintf(stderr, "\n");
+    print_time_row("real", wall_us);
+    print_time_row("user", user_us);
+    print_time_row("sys", sys_us);
+    fprintf(stderr, "%-7s %ld KB\n", "maxrss", maxrss);
+    fprintf(stderr, "%-7s %ld minor / %ld major\n", "faults", minflt, majflt);
+
+    return status;
+}
+
 /**
  * @brief help built-in
- * 
+ *
  * @param cmd Command structure
  * @return int Exit status
  */
@@ -313,13 +951,13 @@ int builtin_help(Command *cmd) {
     
     // If no arguments, show help for all built-ins
     if (cmd->argc == 1) {
-        printf("Shell built-in commands:\n");
+        out_printf("Shell built-in commands:\n");
         
         for (int i = 0; builtin_commands[i].name != NULL; i++) {
-            printf("  %-10s %s\n", builtin_commands[i].name, builtin_commands[i].help);
+            out_printf("  %-10s %s\n", builtin_commands[i].name, builtin_commands[i].help);
         }
         
-        printf("\nType 'help name' to find out more about the function 'name'.\n");
+        out_printf("\nType 'help name' to find out more about the function 'name'.\n");
         return 0;
     }
     
@@ -330,7 +968,7 @@ int builtin_help(Command *cmd) {
         
         for (int j = 0; builtin_commands[j].name != NULL; j++) {
             if (strcmp(name, builtin_commands[j].name) == 0) {
-                printf("%s: %s\n", builtin_commands[j].name, builtin_commands[j].help);
+                out_printf("%s: %s\n", builtin_commands[j].name, builtin_commands[j].help);
                 found = 1;
                 break;
             }
@@ -0,0 +1,307 @@
+/**
+ * @file alias.c
+ * @brief Command alias table implementation
+ *
+ * Fixed-bucket hash table with chained entries. The replacement is
+ * tokenized once when the alias is defined - quote handling included -
+ * so the parser's first-word lookup splices a ready-made token array
+ * into argv instead of reparsing anything.
+ */
+
+#include "command/alias.h"
+#include "utils/error.h"
+#include "utils/string.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Bucket count; chains stay short for any realistic alias set
+#define ALIAS_BUCKETS 64
+
+/**
+ * @brief One alias table entry
+ */
+typedef struct AliasEntry {
+    const char *name;          /**< Interned alias name */
+    char *value;               /**< Replacement text (for printing) */
+    char **tokens;             /**< Pre-tokenized replacement */
+    int num_tokens;            /**< Number of tokens */
+    struct AliasEntry *next;   /**< Bucket chain */
+} AliasEntry;
+
+static AliasEntry *buckets[ALIAS_BUCKETS];
+
+/**
+ * @brief Hash an alias name into a bucket index
+ *
+ * @param name Alias name
+ * @return unsigned int Bucket index
+ */
+static unsigned int hash_name(const char *name) {
+    // djb2
+    unsigned int hash = 5381;
+    while (*name) {
+        hash = hash * 33 + (unsigned char)*name++;
+    }
+    return hash % ALIAS_BUCKETS;
+}
+
+/**
+ * @brief Release one entry
+ *
+ * @param entry Entry to free
+ */
+static void entry_free(AliasEntry *entry) {
+    for (int i = 0; i < entry->num_tokens; i++) {
+        free(entry->tokens[i]);
+    }
+    free(entry->tokens);
+    free(entry->value);
+    // name is interned - the pool owns it
+    free(entry);
+}
+
+/**
+ * @brief Find an entry by name
+ *
+ * @param name Alias name
+ * @return AliasEntry* Entry, NULL if not defined
+ */
+static AliasEntry *find_entry(const char *name) {
+    AliasEntry *entry = buckets[hash_name(name)];
+    while (entry) {
+        // Names are interned, so the lookup from parse_command (which
+        // interns argv[0]) hits on the pointer comparison alone
+        if (entry->name == name || strcmp(entry->name, name) == 0) {
+            return entry;
+        }
+        entry = entry->next;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Tokenize an alias value
+ *
+ * Splits the replacement text on unquoted whitespace, honouring
+ * single quotes, double quotes, and backslash escapes. Each token is
+ * heap-allocated and owned by the entry.
+ *
+ * @param value Replacement text
+ * @param num_tokens Out: number of tokens
+ * @return char** Token array, NULL on error
+ */
+static char **tokenize_value(const char *value, int *num_tokens) {
+    int capacity = 8;
+    int count = 0;
+    char **tokens = malloc(capacity * sizeof(char*));
+    if (!tokens) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return NULL;
+    }
+
+    StrBuilder tok;
+    if (str_builder_init(&tok, 0) != 0) {
+        free(tokens);
+        return NULL;
+    }
+
+    int in_single_quotes = 0;
+    int in_double_quotes = 0;
+    const char *p = value;
+
+    while (1) {
+        char c = *p;
+
+        if (c == '\0' ||
+            (!in_single_quotes && !in_double_quotes &&
+             (c == ' ' || c == '\t'))) {
+            // Token boundary
+            if (tok.length > 0) {
+                if (count >= capacity) {
+                    capacity *= 2;
+                    char **new_tokens =
+                        realloc(tokens, capacity * sizeof(char*));
+                    if (!new_tokens) {
+                        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                        break;
+                    }
+                    tokens = new_tokens;
+                }
+                tokens[count] = str_builder_detach(&tok);
+                if (!tokens[count]) {
+                    break;
+                }
+                count++;
+            }
+            if (c == '\0') {
+                break;
+            }
+            p++;
+        } else if (c == '\\' && !in_single_quotes && *(p + 1) != '\0') {
+            // In double quotes, backslash only escapes certain
+            // characters - same rule as the command tokenizer
+            char next = *(p + 1);
+            if (in_double_quotes &&
+                !(next == '\\' || next == '"' || next == '$' ||
+                  next == '\n')) {
+                str_builder_append_char(&tok, '\\');
+            }
+            str_builder_append_char(&tok, next);
+            p += 2;
+        } else if (c == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+            p++;
+        } else if (c == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+            p++;
+        } else {
+            str_builder_append_char(&tok, c);
+            p++;
+        }
+    }
+
+    str_builder_free(&tok);
+    *num_tokens = count;
+    return tokens;
+}
+
+/**
+ * @brief Define or replace an alias
+ *
+ * The value is tokenized once here, so every later expansion is a
+ * straight splice.
+ *
+ * @param name Alias name
+ * @param value Replacement text
+ * @return int 0 on success, non-zero on error
+ */
+int alias_set(const char *name, const char *value) {
+    if (!name || !value || name[0] == '\0') {
+        return -1;
+    }
+
+    int num_tokens = 0;
+    char **tokens = tokenize_value(value, &num_tokens);
+    if (!tokens) {
+        return -1;
+    }
+
+    const char *name_copy = str_intern(name, strlen(name));
+    char *value_copy = strdup(value);
+    AliasEntry *entry = find_entry(name);
+    AliasEntry *new_entry = entry ? entry : malloc(sizeof(AliasEntry));
+
+    if (!name_copy || !value_copy || !new_entry) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        for (int i = 0; i < num_tokens; i++) free(tokens[i]);
+        free(tokens);
+        free(value_copy);
+        if (!entry) free(new_entry);
+        return -1;
+    }
+
+    if (entry) {
+        // Redefinition: swap out the old contents (the interned name
+        // is simply reused)
+        for (int i = 0; i < entry->num_tokens; i++) free(entry->tokens[i]);
+        free(entry->tokens);
+        free(entry->value);
+    } else {
+        unsigned int bucket = hash_name(name);
+        new_entry->next = buckets[bucket];
+        buckets[bucket] = new_entry;
+    }
+
+    new_entry->name = name_copy;
+    new_entry->value = value_copy;
+    new_entry->tokens = tokens;
+    new_entry->num_tokens = num_tokens;
+    return 0;
+}
+
+/**
+ * @brief Look up an alias's replacement text
+ *
+ * @param name Alias name
+ * @return const char* Replacement text, NULL if not defined
+ */
+const char *alias_get(const char *name) {
+    if (!name) {
+        return NULL;
+    }
+
+    AliasEntry *entry = find_entry(name);
+    return entry ? entry->value : NULL;
+}
+
+/**
+ * @brief Look up an alias's pre-tokenized replacement
+ *
+ * @param name Alias name
+ * @param num_tokens Out: number of tokens
+ * @return char** Token array (table-owned), NULL if not defined
+ */
+char **alias_tokens(const char *name, int *num_tokens) {
+    if (!name || !num_tokens) {
+        return NULL;
+    }
+
+    AliasEntry *entry = find_entry(name);
+    if (!entry) {
+        return NULL;
+    }
+
+    *num_tokens = entry->num_tokens;
+    return entry->tokens;
+}
+
+/**
+ * @brief Remove an alias
+ *
+ * @param name Alias name
+ * @return int 0 on success, non-zero if not defined
+ */
+int alias_remove(const char *name) {
+    if (!name) {
+        return -1;
+    }
+
+    AliasEntry **link = &buckets[hash_name(name)];
+    while (*link) {
+        AliasEntry *entry = *link;
+        if (strcmp(entry->name, name) == 0) {
+            *link = entry->next;
+            entry_free(entry);
+            return 0;
+        }
+        link = &entry->next;
+    }
+    return -1;
+}
+
+/**
+ * @brief Print all defined aliases
+ */
+void alias_print(void) {
+    for (int i = 0; i < ALIAS_BUCKETS; i++) {
+        for (AliasEntry *entry = buckets[i]; entry; entry = entry->next) {
+            printf("alias %s='%s'\n", entry->name, entry->value);
+        }
+    }
+}
+
+/**
+ * @brief Remove all aliases and release the table
+ */
+void alias_cleanup(void) {
+    for (int i = 0; i < ALIAS_BUCKETS; i++) {
+        AliasEntry *entry = buckets[i];
+        while (entry) {
+            AliasEntry *next = entry->next;
+            entry_free(entry);
+            entry = next;
+        }
+        buckets[i] = NULL;
+    }
+}
@@ -8,15 +8,79 @@
 #include "command/executor.h"
 #include "command/command.h"
 #include "builtins/builtins.h"
+#include "jobs/jobs.h"
 #include "utils/error.h"
+#include "utils/memory.h"
+#include "utils/output.h"
 #include "utils/path.h"
+#include "utils/string.h"
+#include "utils/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <time.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 
+/** Process environment for posix_spawn */
+extern char **environ;
+
+/**
+ * @brief Check whether the posix_spawn fast path is enabled
+ *
+ * posix_spawn avoids fork's page-table copy, which dominates spawn
+ * latency when the shell is embedded in a large-RSS process. Enabled
+ * by default; set CSHELL_POSIX_SPAWN=0 to force the fork+execv path.
+ *
+ * @return int 1 if posix_spawn should be used, 0 otherwise
+ */
+static int posix_spawn_enabled(void) {
+    static int enabled = -1;
+
+    if (enabled == -1) {
+        char *value = getenv("CSHELL_POSIX_SPAWN");
+        enabled = (value == NULL || strcmp(value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+/**
+ * @brief Add redirection file actions for posix_spawn
+ *
+ * Translates a RedirectionInfo into spawn file actions so the child
+ * opens its redirection targets itself - no dup2 dance in the parent.
+ *
+ * @param redir Pointer to RedirectionInfo structure
+ * @param actions Initialized file actions object to fill
+ * @return int 0 on success, non-zero on error
+ */
+static int add_redirection_file_actions(RedirectionInfo *redir,
+                                        posix_spawn_file_actions_t *actions) {
+    if (redir->stdout_file != NULL) {
+        int flags = O_WRONLY | O_CREAT | (redir->append_stdout ? O_APPEND : O_TRUNC);
+        if (posix_spawn_file_actions_addopen(actions, STDOUT_FILENO,
+                                             redir->stdout_file, flags, 0644) != 0) {
+            return -1;
+        }
+    }
+
+    if (redir->stderr_file != NULL) {
+        int flags = O_WRONLY | O_CREAT | (redir->append_stderr ? O_APPEND : O_TRUNC);
+        if (posix_spawn_file_actions_addopen(actions, STDERR_FILENO,
+                                             redir->stderr_file, flags, 0644) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 /**
  * @brief Execute a built-in command
  * 
@@ -41,108 +105,224 @@ int execute_builtin_command(Command *cmd) {
 }
 
 /**
- * @brief Execute an external command
- * 
- * Executes the command as an external program.
- * 
+ * @brief Spawn an external command via posix_spawn
+ *
+ * Fast path: spawns the child without duplicating the parent's address
+ * space, with redirections installed through spawn file actions. Does
+ * not wait for the child.
+ *
  * @param cmd Pointer to Command structure
- * @return int Exit status of the command, -1 on error
+ * @param executable_path Resolved path to the executable
+ * @return pid_t Process ID of the child, -1 on spawn failure
  */
-int execute_external_command(Command *cmd) {
-    if (!cmd || cmd->argc == 0) return -1;
-    
-    // Find the executable
-    char *executable_path = find_executable(cmd->argv[0]);
-    if (!executable_path) {
-        fprintf(stderr, "%s: command not found\n", cmd->argv[0]);
+static pid_t spawn_external_command(Command *cmd, const char *executable_path) {
+    posix_spawn_file_actions_t actions;
+
+    if (posix_spawn_file_actions_init(&actions) != 0) {
         return -1;
     }
-    
+
+    if (add_redirection_file_actions(&cmd->redir, &actions) != 0) {
+        posix_spawn_file_actions_destroy(&actions);
+        return -1;
+    }
+
+    // The shell blocks SIGCHLD while spawning; give the child an
+    // empty mask so the block does not leak across exec
+    posix_spawnattr_t attr;
+    sigset_t empty_mask;
+
+    if (posix_spawnattr_init(&attr) != 0) {
+        posix_spawn_file_actions_destroy(&actions);
+        return -1;
+    }
+    sigemptyset(&empty_mask);
+    posix_spawnattr_setsigmask(&attr, &empty_mask);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    pid_t pid;
+    int spawn_result = posix_spawn(&pid, executable_path, &actions, &attr,
+                                   cmd->argv, environ);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (spawn_result != 0) {
+        return -1;
+    }
+
+    return pid;
+}
+
+/**
+ * @brief Launch an external command without waiting
+ *
+ * Spawns the child (posix_spawn fast path, fork+execv fallback) with
+ * redirections applied on the child side, and returns immediately.
+ * Both the foreground and background paths funnel through here.
+ *
+ * @param cmd Pointer to Command structure
+ * @param executable_path Resolved path to the executable
+ * @return pid_t Process ID of the child, -1 on error
+ */
+static pid_t launch_external_command(Command *cmd, const char *executable_path) {
+    // Fast path: posix_spawn with redirections as file actions
+    if (posix_spawn_enabled()) {
+        pid_t pid = spawn_external_command(cmd, executable_path);
+        if (pid != -1) {
+            return pid;
+        }
+        // Spawn failed - fall through to the fork path
+    }
+
     // Create a child process
     pid_t pid = fork();
-    
+
     if (pid < 0) {
         // Fork failed
         ERROR_SYSTEM(ERR_SYSTEM, "Failed to fork process");
-        free(executable_path);
         return -1;
     } else if (pid == 0) {
-        // Child process - execute the command
+        // Child process - drop the inherited SIGCHLD block, apply
+        // redirections, then execute the command
+        jobs_reset_child_sigmask();
+
+        int backup_fds[2] = {-1, -1};
+        int new_fds[2] = {-1, -1};
+
+        if (setup_redirections(&cmd->redir, backup_fds, new_fds) != 0) {
+            exit(1);
+        }
+
         execv(executable_path, cmd->argv);
-        
+
         // If execv returns, it means there was an error
         ERROR_SYSTEM(ERR_SYSTEM, "Failed to execute %s", cmd->argv[0]);
-        free(executable_path);
-        exit(1);
-    } else {
-        // Parent process - wait for child to complete
-        int status;
-        waitpid(pid, &status, 0);
-        free(executable_path);
-        return WEXITSTATUS(status);
+        exit(126);
     }
-    
+
+    return pid;
+}
+
+/**
+ * @brief Execute an external command
+ *
+ * Executes the command as an external program and waits for it.
+ * SIGCHLD is blocked across the wait so the job-control handler
+ * cannot reap the foreground child.
+ *
+ * @param cmd Pointer to Command structure
+ * @return int Exit status of the command, -1 on error
+ */
+int execute_external_command(Command *cmd) {
+    if (!cmd || cmd->argc == 0) return -1;
+
+    // Find the executable
+    const char *executable_path = find_executable(cmd->argv[0]);
+    if (!executable_path) {
+        fprintf(stderr, "%s: command not found\n", cmd->argv[0]);
+        return 127;  // Conventional shell status for command not found
+    }
+
+    jobs_block_sigchld();
+
+    // With SIGCHLD blocked, no background child can be reaped between
+    // these two snapshots, so the RUSAGE_CHILDREN delta is exactly the
+    // foreground command's usage
+    struct rusage ru_before;
+    struct timespec wall_start;
+    int record = rusage_enabled();
+    if (record) {
+        getrusage(RUSAGE_CHILDREN, &ru_before);
+        clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    }
+
+    long span = trace_begin();
+    pid_t pid = launch_external_command(cmd, executable_path);
+    trace_end(TRACE_SPAWN, span);
+
+    if (pid == -1) {
+        jobs_unblock_sigchld();
+        return -1;
+    }
+
+    int status;
+    span = trace_begin();
+    waitpid(pid, &status, 0);
+    trace_end(TRACE_WAIT, span);
+
+    if (record) {
+        struct rusage ru_after;
+        struct timespec wall_end;
+        getrusage(RUSAGE_CHILDREN, &ru_after);
+        clock_gettime(CLOCK_MONOTONIC, &wall_end);
+        long wall_ns = (wall_end.tv_sec - wall_start.tv_sec) * 1000000000L
+                     + (wall_end.tv_nsec - wall_start.tv_nsec);
+        trace_record_rusage(&ru_before, &ru_after, wall_ns);
+    }
+    jobs_unblock_sigchld();
+
+    return WEXITSTATUS(status);
+}
+
+/**
+ * @brief Execute an external command in the background
+ *
+ * Launches the command without waiting, records it in the job table,
+ * and prints the job number and pid in the usual "[n] pid" form.
+ *
+ * @param cmd Pointer to Command structure
+ * @param cmdline Command line as typed (recorded in the job table)
+ * @return int 0 on success, -1 on error, 127 if not found
+ */
+int execute_external_command_background(Command *cmd, const char *cmdline) {
+    if (!cmd || cmd->argc == 0) return -1;
+
+    const char *executable_path = find_executable(cmd->argv[0]);
+    if (!executable_path) {
+        fprintf(stderr, "%s: command not found\n", cmd->argv[0]);
+        return 127;
+    }
+
+    // Keep the handler out until the job is in the table, so a child
+    // that exits instantly is still matched to its entry
+    jobs_block_sigchld();
+
+    pid_t pid = launch_external_command(cmd, executable_path);
+
+    if (pid == -1) {
+        jobs_unblock_sigchld();
+        return -1;
+    }
+
+    int job_id = job_add(pid, cmdline);
+    jobs_unblock_sigchld();
+
+    printf("[%d] %d\n", job_id, (int)pid);
     return 0;
 }
 
 /**
  * @brief Find an executable in PATH
- * 
+ *
  * Searches for an executable in the directories specified by PATH.
- * 
+ *
  * @param command Command name to search for
- * @return char* Path to executable (dynamically allocated, caller must free) or NULL if not found
+ * @return const char* Interned path to executable (do not free) or NULL if not found
  */
-char *find_executable(const char *command) {
+const char *find_executable(const char *command) {
     if (!command) return NULL;
-    
+
     // If command contains a slash, it's a path - just check if it's executable
     if (strchr(command, '/') != NULL) {
         if (access(command, F_OK | X_OK) == 0) {
-            return strdup(command);
+            return str_intern(command, strlen(command));
         }
         return NULL;
     }
-    
-    // Otherwise, search in PATH
-    char *path_env = getenv("PATH");
-    if (!path_env) return NULL;
-    
-    char *path_copy = strdup(path_env);
-    if (!path_copy) {
-        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
-        return NULL;
-    }
-    
-    char *path = strtok(path_copy, ":");
-    char *result = NULL;
-    
-    while (path != NULL) {
-        // Build the full path
-        size_t path_len = strlen(path);
-        size_t cmd_len = strlen(command);
-        size_t full_len = path_len + cmd_len + 2; // +2 for '/' and null terminator
-        
-        char *full_path = malloc(full_len);
-        if (!full_path) {
-            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
-            continue;
-        }
-        
-        snprintf(full_path, full_len, "%s/%s", path, command);
-        
-        // Check if file exists and is executable
-        if (access(full_path, F_OK | X_OK) == 0) {
-            result = full_path;
-            break;
-        }
-        
-        free(full_path);
-        path = strtok(NULL, ":");
-    }
-    
-    free(path_copy);
-    return result;
+
+    // Otherwise, resolve through the executable cache so repeated
+    // lookups don't re-stat every PATH directory
+    return path_search_cached(command);
 }
 
 /**
@@ -175,34 +355,31 @@ int execute_command(Command *cmd) {
  */
 pid_t create_process(Command *cmd) {
     if (!cmd || cmd->argc == 0) return -1;
-    
+
     // Find the executable
-    char *executable_path = find_executable(cmd->argv[0]);
+    const char *executable_path = find_executable(cmd->argv[0]);
     if (!executable_path) {
         fprintf(stderr, "%s: command not found\n", cmd->argv[0]);
         return -1;
     }
-    
+
     // Create a child process
     pid_t pid = fork();
-    
+
     if (pid < 0) {
         // Fork failed
         ERROR_SYSTEM(ERR_SYSTEM, "Failed to fork process");
-        free(executable_path);
         return -1;
     } else if (pid == 0) {
         // Child process - execute the command
         execv(executable_path, cmd->argv);
-        
+
         // If execv returns, it means there was an error
         ERROR_SYSTEM(ERR_SYSTEM, "Failed to execute %s", cmd->argv[0]);
-        free(executable_path);
         exit(1);
     }
-    
+
     // Parent process
-    free(executable_path);
     return pid;
 }
 
@@ -259,4 +436,191 @@ int is_executable(const char *path) {
     if (!path) return 0;
     
     return access(path, F_OK | X_OK) == 0;
-}
\ No newline at end of file
+}
+/**
+ * @brief Run a single pipeline stage in the child process
+ * 
+ * Applies redirections, then executes the stage as a built-in or
+ * external command. Never returns.
+ * 
+ * @param cmd Pointer to Command structure for this stage
+ */
+static void run_pipeline_stage(Command *cmd) {
+    // The parent forked us with SIGCHLD blocked; the block must not
+    // survive into the stage we exec (or the builtin we run)
+    jobs_reset_child_sigmask();
+
+    // Per-stage file redirections override the pipe descriptors
+    int backup_fds[2] = {-1, -1};
+    int new_fds[2] = {-1, -1};
+    
+    if (setup_redirections(&cmd->redir, backup_fds, new_fds) != 0) {
+        exit(1);
+    }
+    
+    // Built-ins run in the child so their output streams through the pipe
+    if (find_builtin(cmd->argv[0])) {
+        BuiltinFunc builtin = find_builtin(cmd->argv[0]);
+        int status = builtin(cmd);
+        // exit() only flushes stdio; the output buffer needs its own
+        // drain before this child goes away
+        out_flush();
+        exit(status);
+    }
+    
+    const char *executable_path = find_executable(cmd->argv[0]);
+    if (!executable_path) {
+        fprintf(stderr, "%s: command not found\n", cmd->argv[0]);
+        exit(127);
+    }
+    
+    execv(executable_path, cmd->argv);
+    
+    // If execv returns, it means there was an error
+    ERROR_SYSTEM(ERR_SYSTEM, "Failed to execute %s", cmd->argv[0]);
+    exit(126);
+}
+
+/**
+ * @brief Spawn all stages of a pipeline
+ *
+ * Forks one child per stage, connected by pipes. Must be called with
+ * SIGCHLD blocked so a stage that exits instantly cannot be reaped by
+ * the job-control handler before the caller has dealt with it.
+ *
+ * @param pipeline Pointer to Pipeline structure
+ * @param pids Out: array of child pids (sized to the stage count)
+ * @return int Number of stages actually spawned
+ */
+static int spawn_pipeline_stages(Pipeline *pipeline, pid_t *pids) {
+    int num_stages = pipeline->num_commands;
+    int prev_read_fd = -1;  // Read end of the previous stage's pipe
+    int num_spawned = 0;
+
+    for (int i = 0; i < num_stages; i++) {
+        int pipe_fds[2] = {-1, -1};
+        
+        // Create a pipe to the next stage (except for the last one)
+        if (i < num_stages - 1 && pipe(pipe_fds) == -1) {
+            ERROR_SYSTEM(ERR_SYSTEM, "Failed to create pipe");
+            if (prev_read_fd != -1) close(prev_read_fd);
+            break;
+        }
+        
+        pid_t pid = fork();
+        
+        if (pid < 0) {
+            // Fork failed - stop spawning, wait for what we started
+            ERROR_SYSTEM(ERR_SYSTEM, "Failed to fork process");
+            if (prev_read_fd != -1) close(prev_read_fd);
+            if (pipe_fds[0] != -1) close(pipe_fds[0]);
+            if (pipe_fds[1] != -1) close(pipe_fds[1]);
+            break;
+        } else if (pid == 0) {
+            // Child - wire stdin/stdout to the neighbouring stages
+            if (prev_read_fd != -1) {
+                dup2(prev_read_fd, STDIN_FILENO);
+                close(prev_read_fd);
+            }
+            if (pipe_fds[1] != -1) {
+                dup2(pipe_fds[1], STDOUT_FILENO);
+                close(pipe_fds[1]);
+            }
+            if (pipe_fds[0] != -1) {
+                close(pipe_fds[0]);
+            }
+            
+            run_pipeline_stage(&pipeline->commands[i]);
+        }
+        
+        // Parent - close the descriptors handed to the child
+        pids[num_spawned++] = pid;
+        
+        if (prev_read_fd != -1) close(prev_read_fd);
+        if (pipe_fds[1] != -1) close(pipe_fds[1]);
+        prev_read_fd = pipe_fds[0];
+    }
+
+    return num_spawned;
+}
+
+/**
+ * @brief Execute a pipeline
+ *
+ * Spawns all pipeline stages concurrently, connected by pipes, and
+ * waits for them to finish.
+ *
+ * @param pipeline Pointer to Pipeline structure
+ * @return int Exit status of the last stage, -1 on error
+ */
+int execute_pipeline(Pipeline *pipeline) {
+    if (!pipeline || pipeline->num_commands == 0) return -1;
+
+    // Pipeline state is per-command scratch - take it from the arena
+    // like the rest of the parse state instead of a malloc/free pair
+    pid_t *pids = arena_alloc(pipeline->num_commands * sizeof(pid_t));
+    if (!pids) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    // Block SIGCHLD before the first fork: a stage that exits while
+    // later stages are still being spawned must not be reaped by the
+    // job-control handler, or the wait loop below loses its status
+    jobs_block_sigchld();
+
+    int num_spawned = spawn_pipeline_stages(pipeline, pids);
+
+    // Wait for all stages; the pipeline status is the last stage's.
+    // SIGCHLD has been blocked since before the first fork, so the
+    // job-control handler cannot have reaped any of them.
+    int status = -1;
+    for (int i = 0; i < num_spawned; i++) {
+        int wait_status;
+        if (waitpid(pids[i], &wait_status, 0) != -1 && i == num_spawned - 1) {
+            status = WIFEXITED(wait_status) ? WEXITSTATUS(wait_status) : -1;
+        }
+    }
+    jobs_unblock_sigchld();
+
+    return status;
+}
+
+/**
+ * @brief Execute a pipeline in the background
+ *
+ * Spawns all stages without waiting and records the last stage in the
+ * job table - its exit is what "[n] Done" reports, matching the
+ * pipeline's foreground status convention. Earlier stages are reaped
+ * by the SIGCHLD handler as they finish.
+ *
+ * @param pipeline Pointer to Pipeline structure
+ * @param cmdline Command line as typed (recorded in the job table)
+ * @return int 0 on success, -1 on error
+ */
+int execute_pipeline_background(Pipeline *pipeline, const char *cmdline) {
+    if (!pipeline || pipeline->num_commands == 0) return -1;
+
+    pid_t *pids = arena_alloc(pipeline->num_commands * sizeof(pid_t));
+    if (!pids) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    // Keep the handler out until the job is in the table, so a
+    // pipeline that finishes instantly is still matched to its entry
+    jobs_block_sigchld();
+
+    int num_spawned = spawn_pipeline_stages(pipeline, pids);
+
+    if (num_spawned == 0) {
+        jobs_unblock_sigchld();
+        return -1;
+    }
+
+    int job_id = job_add(pids[num_spawned - 1], cmdline);
+    jobs_unblock_sigchld();
+
+    printf("[%d] %d\n", job_id, (int)pids[num_spawned - 1]);
+    return 0;
+}
@@ -8,7 +8,11 @@
 #include "terminal/input.h"
 #include "terminal/terminal.h"
 #include "completion/completion.h"
+#include "completion/matcher.h"
+#include "history/history.h"
 #include "utils/error.h"
+#include "utils/string.h"
+#include "utils/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -57,9 +61,189 @@ void line_state_cleanup(LineState *ls) {
     }
 }
 
+/**
+ * @brief Recall a history entry into the line buffer
+ *
+ * Handles Ctrl+P/Ctrl+N and the arrow keys. The first step back
+ * saves the line being edited so stepping forward past the newest
+ * entry restores it.
+ *
+ * @param ls LineState structure
+ * @param hist_index Pointer to navigation position (-1 when not navigating)
+ * @param saved_line Pointer to the saved in-progress line
+ * @param direction -1 for previous (older), +1 for next (newer)
+ */
+static void history_navigate(LineState *ls, int *hist_index,
+                             char **saved_line, int direction) {
+    int count = history_count();
+
+    if (direction < 0) {
+        // Step to an older entry
+        if (count == 0 || *hist_index == 0) {
+            return;
+        }
+        if (*hist_index == -1) {
+            free(*saved_line);
+            *saved_line = strdup(ls->buffer);
+            *hist_index = count;
+        }
+        (*hist_index)--;
+        line_state_set(ls, history_get(*hist_index));
+    } else {
+        // Step to a newer entry, or back to the saved line
+        if (*hist_index == -1) {
+            return;
+        }
+        (*hist_index)++;
+        if (*hist_index >= count) {
+            line_state_set(ls, *saved_line ? *saved_line : "");
+            free(*saved_line);
+            *saved_line = NULL;
+            *hist_index = -1;
+        } else {
+            line_state_set(ls, history_get(*hist_index));
+        }
+    }
+
+    refresh_line(ls->buffer, ls->cursor);
+}
+
+/**
+ * @brief Run incremental reverse history search
+ *
+ * Ctrl+R mode: each typed character narrows the match set through an
+ * IncrementalMatcher over the in-memory history (newest match shown
+ * first), Ctrl+R again steps to the next older match, Backspace
+ * widens, Escape/Ctrl+G cancels, and Enter accepts.
+ *
+ * @param ls LineState structure
+ * @return int 1 if the accepted match should be submitted as the
+ *         line, 0 to resume normal editing
+ */
+static int history_reverse_search(LineState *ls) {
+    int count = history_count();
+
+    const char **candidates = NULL;
+    if (count > 0) {
+        candidates = malloc(count * sizeof(char*));
+        if (!candidates) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return 0;
+        }
+        for (int i = 0; i < count; i++) {
+            candidates[i] = history_get(i);
+        }
+    }
+
+    IncrementalMatcher im;
+    if (incremental_matcher_init(&im, candidates, count) != 0) {
+        free(candidates);
+        return 0;
+    }
+
+    int offset = 0;  // Steps back from the newest surviving match
+    int submit = 0;
+
+    while (1) {
+        // Candidates are oldest-first; show the newest surviving match
+        const char *match = NULL;
+        if (im.num_matches > 0) {
+            match = candidates[im.matches[im.num_matches - 1 - offset]];
+        }
+
+        printf("\r\033[K(reverse-i-search)`%s': %s", im.query, match ? match : "");
+        fflush(stdout);
+
+        int c = read_char();
+
+        if (c == -1 || c == KEY_ESC || c == KEY_CTRL_G) {
+            // Cancel - leave the edited line untouched
+            break;
+        } else if (c == '\n' || c == '\r') {
+            // Accept and submit the match
+            if (match) {
+                line_state_set(ls, match);
+            }
+            submit = 1;
+            break;
+        } else if (c == KEY_CTRL_R) {
+            // Step to the next older match
+            if (offset + 1 < im.num_matches) {
+                offset++;
+            }
+        } else if (c == KEY_BACKSPACE || c == KEY_CTRL_H) {
+            incremental_matcher_pop(&im);
+            offset = 0;
+        } else if (isprint(c)) {
+            incremental_matcher_push(&im, c);
+            offset = 0;
+        } else {
+            // Any other key accepts the match and resumes editing
+            if (match) {
+                line_state_set(ls, match);
+            }
+            break;
+        }
+    }
+
+    incremental_matcher_free(&im);
+    free(candidates);
+    return submit;
+}
+
+// Set when a newline inside a paste submitted the line early: the
+// rest of the paste is picked up by the next read_edited_line()
+static int paste_pending = 0;
+
+/**
+ * @brief Consume bracketed paste content into the line
+ *
+ * Called after the ESC[200~ start marker (or when resuming a
+ * multi-line paste). Collects paste bytes into one block - no
+ * per-character repaint, no tab completion, no control-key handling -
+ * until the ESC[201~ end marker or a newline, then inserts the block
+ * with a single memmove. A newline submits the current line; the rest
+ * of the paste stays queued in the input buffer for the next call.
+ *
+ * @param ls LineState structure
+ * @return int 1 if the line should be submitted, 0 to resume editing
+ */
+static int paste_into_line(LineState *ls) {
+    StrBuilder block;
+    if (str_builder_init(&block, 0) != 0) {
+        return 0;
+    }
+
+    int submit = 0;
+    int c;
+
+    while ((c = read_char()) != -1) {
+        if (c == KEY_ESC) {
+            // Only the paste-end marker is honoured inside a paste
+            if (read_escape_sequence() == SEQ_PASTE_END) {
+                break;
+            }
+        } else if (c == '\n' || c == '\r') {
+            submit = 1;
+            break;
+        } else if (isprint(c) || c == KEY_TAB) {
+            // Tabs are kept as text; other control bytes are dropped
+            str_builder_append_char(&block, c);
+        }
+    }
+
+    paste_pending = submit;
+
+    if (block.length > 0) {
+        insert_text(ls, block.data, (int)block.length);
+    }
+    str_builder_free(&block);
+    return submit;
+}
+
 /**
  * @brief Read a line with editing capabilities
- * 
+ *
  * @param ls LineState structure
  * @return int Characters read or -1 on error
  */
@@ -67,17 +251,33 @@ int read_edited_line(LineState *ls) {
     if (!ls || !ls->buffer) {
         return -1;
     }
-    
+
     int c;
-    
+
+    // History navigation state: -1 means we are editing a new line
+    int hist_index = -1;
+    char *saved_line = NULL;
+
+    // Resume a multi-line paste whose earlier lines were submitted
+    if (paste_pending) {
+        paste_pending = 0;
+        int submit = paste_into_line(ls);
+        refresh_line(ls->buffer, ls->cursor);
+        if (submit) {
+            printf("\n");
+            return ls->length;
+        }
+    }
+
     // Loop until we get a newline or error
     while (1) {
         c = read_char();
-        
+
         if (c == -1) {
+            free(saved_line);
             return -1;
         }
-        
+
         // Process the character
         if (c == '\n' || c == '\r') {
             // Enter key - finish line
@@ -89,12 +289,29 @@ int read_edited_line(LineState *ls) {
             ls->buffer[0] = '\0';
             ls->length = 0;
             ls->cursor = 0;
+            free(saved_line);
             return 0;
         } else if (c == KEY_CTRL_D) {
             // Ctrl+D - EOF (only if buffer is empty)
             if (ls->length == 0) {
+                free(saved_line);
                 return -1;
             }
+        } else if (c == KEY_CTRL_P) {
+            // Ctrl+P - previous history entry
+            history_navigate(ls, &hist_index, &saved_line, -1);
+        } else if (c == KEY_CTRL_N) {
+            // Ctrl+N - next history entry
+            history_navigate(ls, &hist_index, &saved_line, 1);
+        } else if (c == KEY_CTRL_R) {
+            // Ctrl+R - incremental reverse history search; its display
+            // overwrites the line, so force a full repaint after
+            if (history_reverse_search(ls)) {
+                printf("\n");
+                break;
+            }
+            refresh_line_invalidate();
+            refresh_line(ls->buffer, ls->cursor);
         } else if (c == KEY_BACKSPACE || c == KEY_CTRL_H) {
             // Backspace
             if (ls->cursor > 0) {
@@ -102,15 +319,24 @@ int read_edited_line(LineState *ls) {
                 refresh_line(ls->buffer, ls->cursor);
             }
         } else if (c == KEY_TAB) {
-            // Tab completion
+            // Tab completion writes to the terminal on its own
+            long span = trace_begin();
             handle_tab_completion(ls->buffer, &ls->cursor);
+            trace_end(TRACE_COMPLETION, span);
             ls->length = strlen(ls->buffer);
+            refresh_line_invalidate();
             refresh_line(ls->buffer, ls->cursor);
         } else if (c == KEY_ESC) {
             // Escape sequence
             int seq = read_escape_sequence();
             
-            if (seq == SEQ_LEFT) {
+            if (seq == SEQ_UP) {
+                // Up arrow - previous history entry
+                history_navigate(ls, &hist_index, &saved_line, -1);
+            } else if (seq == SEQ_DOWN) {
+                // Down arrow - next history entry
+                history_navigate(ls, &hist_index, &saved_line, 1);
+            } else if (seq == SEQ_LEFT) {
                 // Left arrow
                 move_cursor_left(ls);
                 refresh_line(ls->buffer, ls->cursor);
@@ -134,6 +360,14 @@ int read_edited_line(LineState *ls) {
                     delete_char(ls);
                     refresh_line(ls->buffer, ls->cursor);
                 }
+            } else if (seq == SEQ_PASTE_START) {
+                // Bracketed paste: one block insert, one repaint
+                int submit = paste_into_line(ls);
+                refresh_line(ls->buffer, ls->cursor);
+                if (submit) {
+                    printf("\n");
+                    break;
+                }
             }
         } else if (c == KEY_CTRL_A) {
             // Ctrl+A - Go to beginning of line
@@ -160,15 +394,60 @@ int read_edited_line(LineState *ls) {
             clear_screen();
             refresh_line(ls->buffer, ls->cursor);
         } else if (isprint(c)) {
-            // Printable character - insert
+            // Printable character - insert. If more printable input is
+            // already buffered (rapid typing or a paste), insert it all
+            // and repaint once at the end of the run.
             insert_char(ls, c);
-            refresh_line(ls->buffer, ls->cursor);
+
+            int next = peek_char();
+            if (next == -1 || !isprint(next)) {
+                refresh_line(ls->buffer, ls->cursor);
+            }
         }
     }
-    
+
+    free(saved_line);
     return ls->length;
 }
 
+/**
+ * @brief Replace the line buffer contents
+ *
+ * Replaces the edited line with the given text and moves the cursor
+ * to the end, growing the buffer if needed.
+ *
+ * @param ls LineState structure
+ * @param text New line contents
+ * @return int 0 on success, non-zero on error
+ */
+int line_state_set(LineState *ls, const char *text) {
+    if (!ls || !ls->buffer || !text) {
+        return -1;
+    }
+
+    int len = strlen(text);
+
+    if (len + 1 > ls->capacity) {
+        int new_capacity = ls->capacity;
+        while (len + 1 > new_capacity) {
+            new_capacity *= 2;
+        }
+        char *new_buffer = realloc(ls->buffer, new_capacity);
+        if (!new_buffer) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        ls->buffer = new_buffer;
+        ls->capacity = new_capacity;
+    }
+
+    memcpy(ls->buffer, text, len + 1);
+    ls->length = len;
+    ls->cursor = len;
+
+    return 0;
+}
+
 /**
  * @brief Insert character at cursor
  * 
@@ -210,9 +489,56 @@ int insert_char(LineState *ls, char c) {
     return 0;
 }
 
+/**
+ * @brief Insert a block of text at cursor
+ *
+ * Inserts n bytes in one operation: one capacity check, one memmove
+ * of the tail, one copy. Used for pastes.
+ *
+ * @param ls LineState structure
+ * @param text Bytes to insert
+ * @param n Number of bytes
+ * @return int 0 on success, non-zero on error
+ */
+int insert_text(LineState *ls, const char *text, int n) {
+    if (!ls || !ls->buffer || !text || n < 0) {
+        return -1;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    // Make sure we have enough space for the whole block
+    if (ls->length + n >= ls->capacity) {
+        int new_capacity = ls->capacity;
+        while (ls->length + n >= new_capacity) {
+            new_capacity *= 2;
+        }
+        char *new_buffer = realloc(ls->buffer, new_capacity);
+        if (!new_buffer) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        ls->buffer = new_buffer;
+        ls->capacity = new_capacity;
+    }
+
+    // Make room for the block, then copy it in
+    if (ls->cursor < ls->length) {
+        memmove(ls->buffer + ls->cursor + n, ls->buffer + ls->cursor,
+                ls->length - ls->cursor);
+    }
+    memcpy(ls->buffer + ls->cursor, text, n);
+    ls->cursor += n;
+    ls->length += n;
+    ls->buffer[ls->length] = '\0';
+
+    return 0;
+}
+
 /**
  * @brief Delete character at cursor
- * 
+ *
  * @param ls LineState structure
  * @return int 0 on success, non-zero on error
  */
@@ -430,9 +756,15 @@ int process_key(LineState *ls, int key) {
  * @return int Escape sequence code
  */
 int read_escape_sequence(void) {
+    // A lone Escape press has no follow-up bytes; a real sequence
+    // arrives in the same read and is already buffered
+    if (!input_pending()) {
+        return KEY_ESC;
+    }
+
     // Read the next character
     int c = read_char();
-    
+
     if (c == -1) {
         return KEY_ESC;  // Just an escape key
     }
@@ -464,13 +796,25 @@ int read_escape_sequence(void) {
                 // Two-digit code
                 code = code * 10 + (c - '0');
                 c = read_char();
-                
+
                 if (c == '~') {
                     switch (code) {
                         case 15: return SEQ_HOME;
                         case 17: return SEQ_END;
                         default: return KEY_ESC;
                     }
+                } else if (c >= '0' && c <= '9') {
+                    // Three-digit code (bracketed paste markers)
+                    code = code * 10 + (c - '0');
+                    c = read_char();
+
+                    if (c == '~') {
+                        switch (code) {
+                            case 200: return SEQ_PASTE_START;
+                            case 201: return SEQ_PASTE_END;
+                            default: return KEY_ESC;
+                        }
+                    }
                 }
             }
         } else {
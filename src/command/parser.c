@@ -6,19 +6,735 @@
  */
 
 #include "command/parser.h"
+#include "command/alias.h"
 #include "command/command.h"
+#include "utils/dircache.h"
 #include "utils/error.h"
+#include "utils/memory.h"
 #include "utils/string.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <fnmatch.h>
+
+// Small direct-mapped cache over getenv(): a line referencing the
+// same variable several times does one real lookup. Entries are
+// validated by a generation stamp bumped per parsed command, so a
+// value change between commands is always picked up.
+#define ENV_CACHE_SLOTS 16
+#define ENV_CACHE_NAME_MAX 64
+
+static struct {
+    char name[ENV_CACHE_NAME_MAX];   /**< Variable name */
+    const char *value;               /**< getenv() result (may be NULL) */
+    unsigned long gen;               /**< Generation stamp */
+} env_cache[ENV_CACHE_SLOTS];
+
+static unsigned long env_cache_gen = 0;
+
+/**
+ * @brief Look up a variable through the per-command cache
+ *
+ * @param name Variable name (not NUL-terminated)
+ * @param len Name length
+ * @return const char* Value, NULL if unset
+ */
+static const char *env_lookup_cached(const char *name, size_t len) {
+    if (len >= ENV_CACHE_NAME_MAX) {
+        // Oversized names bypass the cache
+        char buf[256];
+        if (len >= sizeof(buf)) {
+            return NULL;
+        }
+        memcpy(buf, name, len);
+        buf[len] = '\0';
+        return getenv(buf);
+    }
+
+    // djb2 over the name bytes
+    unsigned long hash = 5381;
+    for (size_t i = 0; i < len; i++) {
+        hash = hash * 33 + (unsigned char)name[i];
+    }
+    unsigned int slot = hash % ENV_CACHE_SLOTS;
+
+    if (env_cache[slot].gen == env_cache_gen &&
+        env_cache[slot].name[len] == '\0' &&
+        memcmp(env_cache[slot].name, name, len) == 0) {
+        return env_cache[slot].value;
+    }
+
+    memcpy(env_cache[slot].name, name, len);
+    env_cache[slot].name[len] = '\0';
+    env_cache[slot].value = getenv(env_cache[slot].name);
+    env_cache[slot].gen = env_cache_gen;
+    return env_cache[slot].value;
+}
+
+// Character classes for the fast scanners: scan_class[c] holds the
+// class bits of byte c, and a scanner skips runs of bytes whose
+// classes miss its mask. NUL carries every bit so a skip can never
+// run off the end of the string.
+#define SCAN_ESC    0x01  /**< Backslash */
+#define SCAN_SQ     0x02  /**< Single quote */
+#define SCAN_DQ     0x04  /**< Double quote */
+#define SCAN_BLANK  0x08  /**< Whitespace */
+#define SCAN_GT     0x10  /**< Redirection '>' */
+#define SCAN_GLOB   0x20  /**< Glob wildcards */
+#define SCAN_PIPE   0x40  /**< Pipe '|' */
+#define SCAN_CHAIN  0x80  /**< Chain ';' and '&' */
+
+static const unsigned char scan_class[256] = {
+    ['\0'] = 0xFF,
+    ['\\'] = SCAN_ESC,
+    ['\''] = SCAN_SQ,
+    ['"']  = SCAN_DQ,
+    [' ']  = SCAN_BLANK, ['\t'] = SCAN_BLANK, ['\n'] = SCAN_BLANK,
+    ['\v'] = SCAN_BLANK, ['\f'] = SCAN_BLANK, ['\r'] = SCAN_BLANK,
+    ['>']  = SCAN_GT,
+    ['*']  = SCAN_GLOB, ['?'] = SCAN_GLOB, ['['] = SCAN_GLOB,
+    ['|']  = SCAN_PIPE,
+    ['&']  = SCAN_CHAIN, [';'] = SCAN_CHAIN,
+};
+
+/**
+ * @brief Skip a run of ordinary characters
+ *
+ * Advances over bytes whose class bits miss the mask, eight table
+ * probes per unrolled iteration, so long plain-text runs cost well
+ * under a branch per byte instead of the full state-machine dispatch.
+ * The probes are checked in order and NUL stops every caller, so the
+ * scan never reads past the terminator. Callers choose the mask from
+ * their quote state - inside single quotes it collapses to the one
+ * closing-quote bit, the table equivalent of a memchr.
+ *
+ * @param p Scan position
+ * @param mask Class bits that end the run
+ * @return const char* First byte whose class intersects mask
+ */
+static const char *scan_skip(const char *p, unsigned char mask) {
+    for (;;) {
+        if (scan_class[(unsigned char)p[0]] & mask) return p;
+        if (scan_class[(unsigned char)p[1]] & mask) return p + 1;
+        if (scan_class[(unsigned char)p[2]] & mask) return p + 2;
+        if (scan_class[(unsigned char)p[3]] & mask) return p + 3;
+        if (scan_class[(unsigned char)p[4]] & mask) return p + 4;
+        if (scan_class[(unsigned char)p[5]] & mask) return p + 5;
+        if (scan_class[(unsigned char)p[6]] & mask) return p + 6;
+        if (scan_class[(unsigned char)p[7]] & mask) return p + 7;
+        p += 8;
+    }
+}
+
+/**
+ * @brief Byte range spliced in by variable expansion
+ *
+ * Expanded values are data, not syntax: the tokenizer must not
+ * recognize quotes, escapes, operators, or wildcards inside these
+ * ranges. Offsets index the expanded line.
+ */
+typedef struct {
+    size_t start;   /**< First byte of the expanded value */
+    size_t end;     /**< One past the last byte */
+    int quoted;     /**< Expanded inside double quotes (no word split) */
+} ExpandedSpan;
+
+/**
+ * @brief Find the expansion span covering an offset
+ *
+ * Spans are recorded in increasing offset order and the tokenizer
+ * scans left to right, so a short forward walk finds the match.
+ *
+ * @param spans Span array (may be NULL)
+ * @param count Number of spans
+ * @param off Byte offset into the expanded line
+ * @return const ExpandedSpan* Covering span, NULL if the byte is syntax
+ */
+static const ExpandedSpan *span_find(const ExpandedSpan *spans, int count,
+                                     size_t off) {
+    for (int i = 0; i < count; i++) {
+        if (off < spans[i].start) break;
+        if (off < spans[i].end) return &spans[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Expand $VAR and ${VAR} references in a command line
+ *
+ * Single pass with the same quote-state rules as the tokenizer:
+ * references expand outside quotes and in double quotes, stay literal
+ * in single quotes, and \$ suppresses expansion. The expanded line is
+ * written into a fresh arena buffer (grown arena-style when a value
+ * outruns the estimate); a line without '$' is returned untouched.
+ *
+ * Every spliced value is recorded as an ExpandedSpan so the tokenizer
+ * can treat those bytes as literal data - a value containing quotes,
+ * '>' or wildcards must not be re-parsed as shell syntax.
+ *
+ * @param input Command line (arena memory)
+ * @param spans_out Out: arena array of expanded ranges (NULL if none)
+ * @param num_spans_out Out: number of entries in *spans_out
+ * @return char* Expanded line in the arena, NULL on error
+ */
+static char *expand_variables(char *input, ExpandedSpan **spans_out,
+                              int *num_spans_out) {
+    *spans_out = NULL;
+    *num_spans_out = 0;
+
+    if (strchr(input, '$') == NULL) {
+        return input;
+    }
+
+    // New command, new cache generation
+    env_cache_gen++;
+
+    size_t capacity = strlen(input) + 64;
+    char *out_buf = arena_alloc(capacity);
+    if (!out_buf) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return NULL;
+    }
+    size_t out_len = 0;
+
+    ExpandedSpan *spans = NULL;
+    int num_spans = 0;
+    int span_capacity = 0;
+
+    int in_single_quotes = 0;
+    int in_double_quotes = 0;
+    const char *p = input;
+
+    while (*p != '\0') {
+        const char *chunk = p;       // Bytes to copy through verbatim
+        size_t chunk_len;
+        const char *value = NULL;    // Expansion to splice in
+        size_t value_len = 0;
+
+        char c = *p;
+        if (c == '\\' && !in_single_quotes && *(p + 1) != '\0') {
+            // Keep the escape pair for the tokenizer; \$ stays literal
+            chunk_len = 2;
+            p += 2;
+        } else if (c == '$' && !in_single_quotes) {
+            const char *name;
+            const char *after = p + 1;
+            size_t name_len = 0;
+
+            if (*(p + 1) == '{') {
+                name = p + 2;
+                const char *end = strchr(name, '}');
+                if (end) {
+                    name_len = (size_t)(end - name);
+                    after = end + 1;
+                }
+            } else {
+                name = p + 1;
+                const char *q = name;
+                if (*q == '_' || isalpha((unsigned char)*q)) {
+                    q++;
+                    while (*q == '_' || isalnum((unsigned char)*q)) {
+                        q++;
+                    }
+                }
+                name_len = (size_t)(q - name);
+                after = q;
+            }
+
+            if (name_len > 0) {
+                // Valid reference: an unset variable expands to empty
+                value = env_lookup_cached(name, name_len);
+                value_len = value ? strlen(value) : 0;
+                chunk_len = 0;
+                p = after;
+            } else {
+                // Bare '$' (or unterminated ${) is literal
+                chunk_len = 1;
+                p++;
+            }
+        } else {
+            if (c == '\'' && !in_double_quotes) {
+                in_single_quotes = !in_single_quotes;
+            } else if (c == '"' && !in_single_quotes) {
+                in_double_quotes = !in_double_quotes;
+            }
+            chunk_len = 1;
+            p++;
+        }
+
+        // Grow the arena buffer when the expansion outruns it; the
+        // abandoned block is reclaimed at the next arena_reset()
+        size_t needed = out_len + chunk_len + value_len + 1;
+        if (needed > capacity) {
+            size_t new_capacity = capacity * 2;
+            while (needed > new_capacity) {
+                new_capacity *= 2;
+            }
+            char *new_buf = arena_alloc(new_capacity);
+            if (!new_buf) {
+                ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                return NULL;
+            }
+            memcpy(new_buf, out_buf, out_len);
+            out_buf = new_buf;
+            capacity = new_capacity;
+        }
+
+        if (chunk_len > 0) {
+            memcpy(out_buf + out_len, chunk, chunk_len);
+            out_len += chunk_len;
+        }
+        if (value_len > 0) {
+            // Mark the spliced bytes so the tokenizer keeps them literal
+            if (num_spans >= span_capacity) {
+                int new_capacity = span_capacity ? span_capacity * 2 : 4;
+                ExpandedSpan *new_spans =
+                    arena_alloc(new_capacity * sizeof(ExpandedSpan));
+                if (!new_spans) {
+                    ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                    return NULL;
+                }
+                memcpy(new_spans, spans, num_spans * sizeof(ExpandedSpan));
+                spans = new_spans;
+                span_capacity = new_capacity;
+            }
+            spans[num_spans].start = out_len;
+            spans[num_spans].end = out_len + value_len;
+            spans[num_spans].quoted = in_double_quotes;
+            num_spans++;
+
+            memcpy(out_buf + out_len, value, value_len);
+            out_len += value_len;
+        }
+    }
+
+    out_buf[out_len] = '\0';
+    *spans_out = spans;
+    *num_spans_out = num_spans;
+    return out_buf;
+}
+
+/**
+ * @brief Scan one token in place
+ *
+ * Consumes a word starting at *pp, handling quotes and escapes, and
+ * compacts its unquoted bytes to *outp (always at or behind the read
+ * position, so the rewrite is safe). The delimiter that ended the
+ * word is stored in *delim and consumed, then the token is
+ * NUL-terminated.
+ *
+ * Bytes inside an expanded span are copied through as data: quotes,
+ * escapes, '>' and wildcards from a variable's value never act as
+ * syntax. An unquoted expansion still word-splits on blanks; a quoted
+ * one comes through whole.
+ *
+ * @param pp In/out read position
+ * @param outp In/out write position
+ * @param delim Out: delimiter that ended the token (' ', '>', or '\0')
+ * @param globp Out: set to 1 if the token contains an unquoted glob
+ *              character (may be NULL)
+ * @param base Start of the line (for span offsets)
+ * @param spans Expanded ranges to treat as literal (may be NULL)
+ * @param num_spans Number of entries in spans
+ * @return int 0 on success, non-zero on unclosed quotes
+ */
+static int scan_token(char **pp, char **outp, char *delim, int *globp,
+                      const char *base, const ExpandedSpan *spans,
+                      int num_spans) {
+    char *p = *pp;
+    char *out = *outp;
+    int in_single_quotes = 0;
+    int in_double_quotes = 0;
+
+    // Bytes that drop the scan into the state machine; unquoted glob
+    // characters only matter when the caller asked for the flag
+    unsigned char plain_mask = SCAN_ESC | SCAN_SQ | SCAN_DQ | SCAN_BLANK |
+                               SCAN_GT | (globp ? SCAN_GLOB : 0);
+
+    while (*p != '\0') {
+        // Expanded bytes are data: copy the span through untouched,
+        // except that an unquoted expansion word-splits on blanks
+        const ExpandedSpan *span =
+            span_find(spans, num_spans, (size_t)(p - base));
+        if (span) {
+            char *span_end = (char *)base + span->end;
+            char *stop = span_end;
+            if (!span->quoted && !in_single_quotes && !in_double_quotes) {
+                for (char *q = p; q < span_end; q++) {
+                    if (*q == ' ' || *q == '\t') {
+                        stop = q;
+                        break;
+                    }
+                }
+            }
+            memmove(out, p, (size_t)(stop - p));
+            out += stop - p;
+            p = stop;
+            if (p < span_end) break;  // Blank in the value ends the token
+            continue;
+        }
+
+        // Bulk-copy the run of ordinary bytes before the next
+        // interesting one; inside quotes the mask shrinks to the
+        // characters that can end or escape the region
+        unsigned char mask = in_single_quotes ? SCAN_SQ
+                           : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                           : plain_mask;
+        char *run = p;
+        p = (char *)scan_skip(p, mask);
+        if (p > run) {
+            memmove(out, run, (size_t)(p - run));
+            out += p - run;
+        }
+        if (*p == '\0') break;
+
+        // The bulk skip may have stopped on an expanded byte; let the
+        // span branch above deal with it as data
+        if (spans && span_find(spans, num_spans, (size_t)(p - base))) {
+            continue;
+        }
+
+        char c = *p;
+
+        if (c == '\\' && !in_single_quotes) {
+            p++;
+            if (*p == '\0') {
+                *out++ = '\\';
+                break;
+            }
+            if (in_double_quotes) {
+                // In double quotes, backslash only escapes certain characters
+                if (*p == '\\' || *p == '"' || *p == '$' || *p == '\n') {
+                    *out++ = *p;
+                } else {
+                    *out++ = '\\';
+                    *out++ = *p;
+                }
+            } else {
+                // Outside quotes, backslash escapes any character
+                *out++ = *p;
+            }
+            p++;
+        } else if (c == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+            p++;
+        } else if (c == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+            p++;
+        } else if (!in_single_quotes && !in_double_quotes &&
+                   (c == ' ' || c == '\t' || c == '>')) {
+            break;
+        } else {
+            // Only unquoted wildcards make a token a glob pattern
+            if (globp && !in_single_quotes && !in_double_quotes &&
+                (c == '*' || c == '?' || c == '[')) {
+                *globp = 1;
+            }
+            *out++ = c;
+            p++;
+        }
+    }
+
+    if (in_single_quotes || in_double_quotes) {
+        ERROR_ERROR(ERR_SYNTAX, "Unclosed quotes in command");
+        return -1;
+    }
+
+    // Record and consume the delimiter, then terminate the token; the
+    // write position is strictly behind the read position by now
+    *delim = *p;
+    if (*p != '\0') {
+        p++;
+    }
+    *out++ = '\0';
+
+    *pp = p;
+    *outp = out;
+    return 0;
+}
+
+/**
+ * @brief Grow an argv array in the command arena
+ *
+ * @param argv Current array
+ * @param argc Number of live entries
+ * @param capacity In/out capacity
+ * @return char** Grown array, NULL on failure
+ */
+static char **grow_argv(char **argv, int argc, int *capacity) {
+    int new_capacity = *capacity * 2;
+    char **new_argv = arena_alloc(new_capacity * sizeof(char*));
+    if (!new_argv) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return NULL;
+    }
+
+    memcpy(new_argv, argv, argc * sizeof(char*));
+    *capacity = new_capacity;
+    return new_argv;
+}
+
+/**
+ * @brief Append one argument to a command's argv
+ *
+ * Grows the array when needed, keeping room for the NULL terminator.
+ *
+ * @param cmd Command being filled
+ * @param capacity In/out argv capacity
+ * @param arg Argument to append (not copied)
+ * @return int 0 on success, non-zero on error
+ */
+static int push_arg(Command *cmd, int *capacity, char *arg) {
+    if (cmd->argc >= *capacity - 1) {
+        cmd->argv = grow_argv(cmd->argv, cmd->argc, capacity);
+        if (!cmd->argv) return -1;
+    }
+    cmd->argv[cmd->argc++] = arg;
+    return 0;
+}
+
+/**
+ * @brief Expand a glob pattern into a command's argv
+ *
+ * Splits the word at its last '/' into a literal directory part and a
+ * filename pattern, matches the pattern against the directory's cached
+ * listing (see dircache.h), and appends each match. Entries come out
+ * of the cache name-sorted, so matches are appended in order. Hidden
+ * files require an explicit leading '.' in the pattern. When nothing
+ * matches - or the directory part is unreadable - the pattern itself
+ * is kept as the argument, matching sh behaviour.
+ *
+ * @param word Glob pattern (quotes already removed)
+ * @param cmd Command being filled
+ * @param capacity In/out argv capacity
+ * @return int 0 on success, non-zero on error
+ */
+static int expand_glob_word(char *word, Command *cmd, int *capacity) {
+    // The directory part is taken literally; wildcards are only
+    // matched against the final path component
+    char *slash = strrchr(word, '/');
+    const char *dir = ".";
+    const char *pattern = word;
+    size_t prefix_len = 0;  // Length of the kept "dir/" prefix
+
+    if (slash) {
+        prefix_len = (size_t)(slash - word) + 1;
+        pattern = slash + 1;
+        if (slash == word) {
+            dir = "/";
+        } else {
+            char *dir_copy = arena_alloc(prefix_len);
+            if (!dir_copy) {
+                ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                return -1;
+            }
+            memcpy(dir_copy, word, prefix_len - 1);
+            dir_copy[prefix_len - 1] = '\0';
+            dir = dir_copy;
+        }
+    }
+
+    int count = 0;
+    const DirCacheEntry *entries = dir_cache_get(dir, &count);
+    if (!entries) {
+        return push_arg(cmd, capacity, word);
+    }
+
+    int matched = 0;
+    for (int i = 0; i < count; i++) {
+        if (fnmatch(pattern, entries[i].name, FNM_PERIOD) != 0) {
+            continue;
+        }
+
+        size_t name_len = strlen(entries[i].name);
+        char *arg = arena_alloc(prefix_len + name_len + 1);
+        if (!arg) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        memcpy(arg, word, prefix_len);
+        memcpy(arg + prefix_len, entries[i].name, name_len + 1);
+
+        if (push_arg(cmd, capacity, arg) != 0) return -1;
+        matched++;
+    }
+
+    // No match: the pattern stands as a literal argument
+    if (matched == 0) {
+        return push_arg(cmd, capacity, word);
+    }
+    return 0;
+}
+
+/**
+ * @brief Tokenize a command line in a single pass
+ *
+ * Unified tokenizer: one scan over the input handles quote and
+ * escape state, splits argv words, and captures redirection
+ * operators (>, >>, 1>, 2>, ...) with their targets. Words are
+ * compacted in place, so cmd->argv points straight into the
+ * (arena-allocated) input buffer - no per-argument copy and no
+ * fixed length limit.
+ *
+ * @param input Input string to parse (must be arena memory; modified)
+ * @param cmd Pointer to Command structure to fill
+ * @return int 0 on success, non-zero on error
+ */
+int parse_command_line(char *input, Command *cmd) {
+    if (!input || !cmd) return -1;
+
+    // Expand $VAR / ${VAR} first; a line without '$' comes back
+    // untouched and costs one strchr. The spans mark which bytes came
+    // from values, so the scan below never mistakes them for syntax
+    ExpandedSpan *spans = NULL;
+    int num_spans = 0;
+    input = expand_variables(input, &spans, &num_spans);
+    if (!input) return -1;
+
+    int capacity = 16;
+    cmd->argv = arena_alloc(capacity * sizeof(char*));
+    if (!cmd->argv) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+    cmd->argc = 0;
+
+    char *p = input;    // Read position
+    char *out = input;  // Write position (compacted tokens)
+    char delim = 0;
+
+    while (1) {
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0') break;
+
+        int fd = 0;  // Pending redirection: 0 = none
+        int had_glob = 0;
+        char *word = out;
+
+        if (*p == '>' &&
+            !span_find(spans, num_spans, (size_t)(p - input))) {
+            // Bare redirection operator ('>' from an expanded value is
+            // an argument, not an operator)
+            fd = 1;
+            p++;
+        } else {
+            if (scan_token(&p, &out, &delim, &had_glob,
+                           input, spans, num_spans) != 0) {
+                return -1;
+            }
+
+            if (delim == '>' &&
+                (strcmp(word, "1") == 0 || strcmp(word, "2") == 0) &&
+                !span_find(spans, num_spans, (size_t)(p - 2 - input))) {
+                // A lone fd digit attached to '>' is part of the
+                // operator, not an argument - unless the digit came
+                // from an expanded value, which is always data
+                fd = word[0] - '0';
+                out = word;
+            } else {
+                if (had_glob) {
+                    // Wildcard word: expand against the cached
+                    // directory listing
+                    if (expand_glob_word(word, cmd, &capacity) != 0) {
+                        return -1;
+                    }
+                } else if (push_arg(cmd, &capacity, word) != 0) {
+                    return -1;
+                }
+                if (delim == '>') {
+                    fd = 1;
+                }
+            }
+        }
+
+        // Consume one or more chained redirections; '>' bytes from an
+        // expanded value are target text, never part of the operator
+        while (fd != 0) {
+            int append = 0;
+            if (*p == '>' &&
+                !span_find(spans, num_spans, (size_t)(p - input))) {
+                append = 1;
+                p++;
+            }
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == '\0' ||
+                (*p == '>' &&
+                 !span_find(spans, num_spans, (size_t)(p - input)))) {
+                ERROR_ERROR(ERR_SYNTAX, "Missing redirection target");
+                return -1;
+            }
+
+            char *target = out;
+            if (scan_token(&p, &out, &delim, NULL,
+                           input, spans, num_spans) != 0) {
+                return -1;
+            }
+
+            if (fd == 2) {
+                cmd->redir.stderr_file = target;
+                cmd->redir.append_stderr = append;
+            } else {
+                cmd->redir.stdout_file = target;
+                cmd->redir.append_stdout = append;
+            }
+
+            // The target may itself be followed by another operator
+            fd = (delim == '>') ? 1 : 0;
+        }
+    }
+
+    cmd->argv[cmd->argc] = NULL;
+
+    // Intern the command word: the alias table and the executable
+    // cache both key on interned pointers, so repeated commands hash
+    // once and compare by identity, and a long batch run stores one
+    // copy of each distinct name
+    if (cmd->argc > 0) {
+        const char *interned = str_intern(cmd->argv[0], strlen(cmd->argv[0]));
+        if (interned) {
+            cmd->argv[0] = (char *)interned;
+        }
+    }
+
+    // First-word alias lookup: splice the pre-tokenized replacement
+    // in front of the remaining arguments - no reparse of the line.
+    // One pass only, so self-referential aliases cannot loop.
+    if (cmd->argc > 0) {
+        int num_tokens = 0;
+        char **tokens = alias_tokens(cmd->argv[0], &num_tokens);
+        if (tokens && num_tokens > 0) {
+            char **new_argv =
+                arena_alloc((cmd->argc + num_tokens) * sizeof(char*));
+            if (!new_argv) {
+                ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                return -1;
+            }
+            for (int i = 0; i < num_tokens; i++) {
+                // The spliced command word is interned like any other
+                new_argv[i] = i == 0
+                    ? (char *)str_intern(tokens[i], strlen(tokens[i]))
+                    : arena_strdup(tokens[i]);
+                if (!new_argv[i]) {
+                    ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                    return -1;
+                }
+            }
+            // Copies the old arguments and the NULL terminator
+            memcpy(new_argv + num_tokens, cmd->argv + 1,
+                   cmd->argc * sizeof(char*));
+            cmd->argv = new_argv;
+            cmd->argc += num_tokens - 1;
+        }
+    }
+    return 0;
+}
 
 /**
  * @brief Parse redirections from input string
- * 
+ *
  * Extracts redirection operators from a command string.
- * 
+ *
  * @param input Command string (will be modified)
  * @param redir RedirectionInfo structure to fill
  * @return int 0 on success, non-zero on error
@@ -37,6 +753,14 @@ int parse_redirections(char *input, RedirectionInfo *redir) {
     
     char *current = input;
     while (*current != '\0') {
+        // Skip runs of ordinary bytes; only quote characters, escapes,
+        // and (outside quotes) '>' can change anything here
+        current = (char *)scan_skip(current,
+                                    in_single_quotes ? SCAN_SQ
+                                    : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                                    : (SCAN_ESC | SCAN_SQ | SCAN_DQ | SCAN_GT));
+        if (*current == '\0') break;
+
         if (*current == '\\' && !in_single_quotes) {
             // Skip the escaped character
             current++;
@@ -131,8 +855,8 @@ int parse_redirections(char *input, RedirectionInfo *redir) {
             }
         }
 
-        // Store the filename
-        redir->stdout_file = strdup(filename);
+        // Store the filename in the command arena
+        redir->stdout_file = arena_strdup(filename);
         if (!redir->stdout_file) {
             ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
             return -1;
@@ -180,8 +904,8 @@ int parse_redirections(char *input, RedirectionInfo *redir) {
                 end--;
             }
             
-            // Store the filename
-            redir->stderr_file = strdup(filename);
+            // Store the filename in the command arena
+            redir->stderr_file = arena_strdup(filename);
             if (!redir->stderr_file) {
                 ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
                 return -1;
@@ -206,49 +930,61 @@ int parse_redirections(char *input, RedirectionInfo *redir) {
  */
 int parse_command(char *input, Command *cmd) {
     if (!input || !cmd) return -1;
-    
-    // Estimate max number of arguments (will be adjusted as needed)
-    int max_args = 64;
-    cmd->argv = malloc(max_args * sizeof(char*));
+
+    int capacity = 16;
+    cmd->argv = arena_alloc(capacity * sizeof(char*));
     if (!cmd->argv) {
         ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
         return -1;
     }
-    
-    // Initialize argv array
-    memset(cmd->argv, 0, max_args * sizeof(char*));
     cmd->argc = 0;
-    
-    // Parse input with quote and backslash handling
+
+    // Parse input with quote and backslash handling; the current
+    // argument grows in a string builder, so there is no length cap
     char *current = input;
-    char arg[1024]; // Temporary buffer for building arguments
-    int arg_pos = 0;
+    StrBuilder arg;
     int in_single_quotes = 0;
     int in_double_quotes = 0;
-    
+
+    if (str_builder_init(&arg, 0) != 0) {
+        return -1;
+    }
+
     // Trim leading whitespace
     while (isspace(*current)) current++;
-    
-    while (*current != '\0' && cmd->argc < (max_args - 1)) {
+
+    while (*current != '\0') {
+        // Append the run of ordinary bytes before the next quote,
+        // escape, or (unquoted) separator in one go
+        const char *run = current;
+        current = (char *)scan_skip(current,
+                                    in_single_quotes ? SCAN_SQ
+                                    : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                                    : (SCAN_ESC | SCAN_SQ | SCAN_DQ | SCAN_BLANK));
+        if (current > run) {
+            str_builder_append_n(&arg, run, (size_t)(current - run));
+        }
+        if (*current == '\0') break;
+
         // Handle backslash escaping - only outside single quotes
         if (*current == '\\' && !in_single_quotes) {
             if (in_double_quotes) {
                 // In double quotes, backslash only escapes certain characters
                 current++;
                 if (*current == '\\' || *current == '"' || *current == '$' || *current == '\n') {
-                    if (arg_pos < 1023) arg[arg_pos++] = *current;
+                    str_builder_append_char(&arg, *current);
                 } else {
                     // Otherwise keep both the backslash and the character
-                    if (arg_pos < 1023) arg[arg_pos++] = '\\';
-                    if (*current != '\0' && arg_pos < 1023) {
-                        arg[arg_pos++] = *current;
+                    str_builder_append_char(&arg, '\\');
+                    if (*current != '\0') {
+                        str_builder_append_char(&arg, *current);
                     }
                 }
             } else {
                 // Outside quotes, backslash escapes any character
                 current++;
-                if (*current != '\0' && arg_pos < 1023) {
-                    arg[arg_pos++] = *current;
+                if (*current != '\0') {
+                    str_builder_append_char(&arg, *current);
                 }
             }
         } else if (*current == '\'' && !in_double_quotes) {
@@ -259,186 +995,195 @@ int parse_command(char *input, Command *cmd) {
             in_double_quotes = !in_double_quotes;
         } else if (isspace(*current) && !in_single_quotes && !in_double_quotes) {
             // Space outside quotes - end of argument
-            if (arg_pos > 0) {
-                arg[arg_pos] = '\0';
-                cmd->argv[cmd->argc] = strdup(arg);
+            if (arg.length > 0) {
+                if (cmd->argc >= capacity - 1) {
+                    cmd->argv = grow_argv(cmd->argv, cmd->argc, &capacity);
+                    if (!cmd->argv) {
+                        str_builder_free(&arg);
+                        return -1;
+                    }
+                }
+                cmd->argv[cmd->argc] = arena_strdup(arg.data);
                 if (!cmd->argv[cmd->argc]) {
                     ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                    str_builder_free(&arg);
                     return -1;
                 }
                 cmd->argc++;
-                arg_pos = 0;
+                str_builder_clear(&arg);
             }
-            
+
             // Skip consecutive spaces
             while (isspace(*current)) current++;
             continue;
         } else {
             // Regular character - add to current argument
-            if (arg_pos < 1023) arg[arg_pos++] = *current;
+            str_builder_append_char(&arg, *current);
         }
-        
+
         current++;
     }
-    
+
     // Check for unclosed quotes
     if (in_single_quotes || in_double_quotes) {
         ERROR_ERROR(ERR_SYNTAX, "Unclosed quotes in command");
+        str_builder_free(&arg);
         return -1;
     }
-    
+
     // Handle the last argument if there is one
-    if (arg_pos > 0) {
-        arg[arg_pos] = '\0';
-        cmd->argv[cmd->argc] = strdup(arg);
+    if (arg.length > 0) {
+        if (cmd->argc >= capacity - 1) {
+            cmd->argv = grow_argv(cmd->argv, cmd->argc, &capacity);
+            if (!cmd->argv) {
+                str_builder_free(&arg);
+                return -1;
+            }
+        }
+        cmd->argv[cmd->argc] = arena_strdup(arg.data);
         if (!cmd->argv[cmd->argc]) {
             ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            str_builder_free(&arg);
             return -1;
         }
         cmd->argc++;
     }
-    
+
+    str_builder_free(&arg);
+
     // NULL terminate the argument list
     cmd->argv[cmd->argc] = NULL;
-    
+
     return 0;
 }
 
 /**
  * @brief Parse echo command arguments
- * 
+ *
  * Special handling for echo command arguments with escape sequences.
- * 
+ * Output grows in the caller's string builder, so arguments of any
+ * length come through untruncated.
+ *
  * @param input Input arguments string
- * @param output Output buffer for processed arguments
- * @param output_size Size of output buffer
+ * @param output Builder for the processed arguments (appended to)
  */
-void parse_echo_args(const char *input, char *output, size_t output_size) {
-    if (!input || !output || output_size == 0) return;
-    
+void parse_echo_args(const char *input, StrBuilder *output) {
+    if (!input || !output) return;
+
     size_t in_pos = 0;
-    size_t out_pos = 0;
-    
-    while (input[in_pos] != '\0' && out_pos < output_size - 1) {
+
+    while (input[in_pos] != '\0') {
         // Handle escape sequences
         if (input[in_pos] == '\\') {
             in_pos++;
             if (input[in_pos] == '\0') {
                 // Backslash at end of string
-                if (out_pos < output_size - 1) {
-                    output[out_pos++] = '\\';
-                }
+                str_builder_append_char(output, '\\');
                 break;
             }
-            
+
             // Process escape sequence
             switch (input[in_pos]) {
                 case 'n':  // Newline
-                    output[out_pos++] = '\n';
+                    str_builder_append_char(output, '\n');
                     break;
                 case 't':  // Tab
-                    output[out_pos++] = '\t';
+                    str_builder_append_char(output, '\t');
                     break;
                 case 'r':  // Carriage return
-                    output[out_pos++] = '\r';
+                    str_builder_append_char(output, '\r');
                     break;
                 case '\\': // Backslash
-                    output[out_pos++] = '\\';
+                    str_builder_append_char(output, '\\');
                     break;
                 case '\'': // Single quote
-                    output[out_pos++] = '\'';
+                    str_builder_append_char(output, '\'');
                     break;
                 case '"':  // Double quote
-                    output[out_pos++] = '"';
+                    str_builder_append_char(output, '"');
                     break;
                 default:   // Other characters
                     // Keep both the backslash and the character
-                    if (out_pos < output_size - 2) {
-                        output[out_pos++] = '\\';
-                        output[out_pos++] = input[in_pos];
-                    }
+                    str_builder_append_char(output, '\\');
+                    str_builder_append_char(output, input[in_pos]);
                     break;
             }
         } else {
             // Copy regular character
-            output[out_pos++] = input[in_pos];
+            str_builder_append_char(output, input[in_pos]);
         }
-        
+
         in_pos++;
     }
-    
-    // Null-terminate the output
-    output[out_pos] = '\0';
 }
 
 /**
  * @brief Process escape sequences
- * 
- * Processes escape sequences in a string.
- * 
+ *
+ * Processes escape sequences in a string, appending the result to
+ * the caller's string builder.
+ *
  * @param input Input string with escape sequences
- * @param output Output buffer for processed string
- * @param output_size Size of output buffer
- * @return size_t Number of bytes written to output
+ * @param output Builder for the processed string (appended to)
+ * @return size_t Number of bytes appended to output
  */
-size_t process_escapes(const char *input, char *output, size_t output_size) {
-    if (!input || !output || output_size == 0) return 0;
-    
+size_t process_escapes(const char *input, StrBuilder *output) {
+    if (!input || !output) return 0;
+
     size_t in_pos = 0;
-    size_t out_pos = 0;
-    
-    while (input[in_pos] != '\0' && out_pos < output_size - 1) {
+    size_t start_length = output->length;
+
+    while (input[in_pos] != '\0') {
         if (input[in_pos] == '\\') {
             in_pos++;
             if (input[in_pos] == '\0') {
                 // Backslash at end of string
                 break;
             }
-            
+
             // Process escape sequence
             switch (input[in_pos]) {
-                case 'n':  output[out_pos++] = '\n'; break;
-                case 't':  output[out_pos++] = '\t'; break;
-                case 'r':  output[out_pos++] = '\r'; break;
-                case 'a':  output[out_pos++] = '\a'; break;
-                case 'b':  output[out_pos++] = '\b'; break;
-                case 'f':  output[out_pos++] = '\f'; break;
-                case 'v':  output[out_pos++] = '\v'; break;
-                case '\\': output[out_pos++] = '\\'; break;
-                case '\'': output[out_pos++] = '\''; break;
-                case '"':  output[out_pos++] = '"';  break;
-                default:   output[out_pos++] = input[in_pos]; break;
+                case 'n':  str_builder_append_char(output, '\n'); break;
+                case 't':  str_builder_append_char(output, '\t'); break;
+                case 'r':  str_builder_append_char(output, '\r'); break;
+                case 'a':  str_builder_append_char(output, '\a'); break;
+                case 'b':  str_builder_append_char(output, '\b'); break;
+                case 'f':  str_builder_append_char(output, '\f'); break;
+                case 'v':  str_builder_append_char(output, '\v'); break;
+                case '\\': str_builder_append_char(output, '\\'); break;
+                case '\'': str_builder_append_char(output, '\''); break;
+                case '"':  str_builder_append_char(output, '"');  break;
+                default:   str_builder_append_char(output, input[in_pos]); break;
             }
         } else {
-            output[out_pos++] = input[in_pos];
+            str_builder_append_char(output, input[in_pos]);
         }
-        
+
         in_pos++;
     }
-    
-    output[out_pos] = '\0';
-    return out_pos;
+
+    return output->length - start_length;
 }
 
 /**
  * @brief Handle quotes in a string
- * 
- * Removes quotes and handles quoted content.
- * 
+ *
+ * Removes quotes and handles quoted content, appending the result to
+ * the caller's string builder.
+ *
  * @param input Input string with quotes
- * @param output Output buffer for processed string
- * @param output_size Size of output buffer
- * @return size_t Number of bytes written to output
+ * @param output Builder for the processed string (appended to)
+ * @return size_t Number of bytes appended to output
  */
-size_t process_quotes(const char *input, char *output, size_t output_size) {
-    if (!input || !output || output_size == 0) return 0;
-    
+size_t process_quotes(const char *input, StrBuilder *output) {
+    if (!input || !output) return 0;
+
     size_t in_pos = 0;
-    size_t out_pos = 0;
+    size_t start_length = output->length;
     int in_single_quotes = 0;
     int in_double_quotes = 0;
-    
-    while (input[in_pos] != '\0' && out_pos < output_size - 1) {
+
+    while (input[in_pos] != '\0') {
         if (input[in_pos] == '\'' && !in_double_quotes) {
             // Toggle single quote state
             in_single_quotes = !in_single_quotes;
@@ -451,40 +1196,37 @@ size_t process_quotes(const char *input, char *output, size_t output_size) {
                 // Handle escape sequence
                 in_pos++;
                 if (input[in_pos] == '\0') break;
-                
+
                 if (in_double_quotes) {
                     // In double quotes, only certain characters are escaped
-                    if (input[in_pos] == '\\' || input[in_pos] == '"' || 
+                    if (input[in_pos] == '\\' || input[in_pos] == '"' ||
                         input[in_pos] == '$' || input[in_pos] == '\n') {
-                        output[out_pos++] = input[in_pos];
+                        str_builder_append_char(output, input[in_pos]);
                     } else {
                         // Otherwise keep both the backslash and the character
-                        if (out_pos < output_size - 2) {
-                            output[out_pos++] = '\\';
-                            output[out_pos++] = input[in_pos];
-                        }
+                        str_builder_append_char(output, '\\');
+                        str_builder_append_char(output, input[in_pos]);
                     }
                 } else {
                     // Outside quotes, all characters can be escaped
-                    output[out_pos++] = input[in_pos];
+                    str_builder_append_char(output, input[in_pos]);
                 }
             } else {
                 // Regular character
-                output[out_pos++] = input[in_pos];
+                str_builder_append_char(output, input[in_pos]);
             }
         }
-        
+
         in_pos++;
     }
-    
+
     // Check for unclosed quotes
     if (in_single_quotes || in_double_quotes) {
         ERROR_ERROR(ERR_SYNTAX, "Unclosed quotes in string");
         return 0;
     }
-    
-    output[out_pos] = '\0';
-    return out_pos;
+
+    return output->length - start_length;
 }
 
 /**
@@ -503,6 +1245,14 @@ int validate_command_syntax(const char *input) {
     const char *current = input;
     
     while (*current != '\0') {
+        // Skip to the next byte the validator cares about; escapes
+        // count even inside quotes here, matching the checks below
+        current = scan_skip(current,
+                            in_single_quotes ? (SCAN_ESC | SCAN_SQ)
+                            : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                            : (SCAN_ESC | SCAN_SQ | SCAN_DQ | SCAN_GT));
+        if (*current == '\0') break;
+
         if (*current == '\\') {
             // Skip escaped character
             current++;
@@ -545,4 +1295,309 @@ int validate_command_syntax(const char *input) {
     }
     
     return 0;
-}
\ No newline at end of file
+}
+/**
+ * @brief Check for an unquoted pipe operator
+ * 
+ * Scans a command line for a '|' outside quotes and escapes.
+ * 
+ * @param input Command string to scan
+ * @return int 1 if the line contains a pipeline, 0 otherwise
+ */
+int contains_unquoted_pipe(const char *input) {
+    if (!input) return 0;
+    
+    int in_single_quotes = 0;
+    int in_double_quotes = 0;
+    
+    for (const char *current = input; *current != '\0'; current++) {
+        // Skip ahead to the next quote, escape, or candidate pipe
+        current = scan_skip(current,
+                            in_single_quotes ? SCAN_SQ
+                            : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                            : (SCAN_ESC | SCAN_SQ | SCAN_DQ | SCAN_PIPE));
+        if (*current == '\0') break;
+
+        if (*current == '\\' && !in_single_quotes) {
+            // Skip the escaped character
+            if (*(current + 1) != '\0') current++;
+        } else if (*current == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+        } else if (*current == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+        } else if (*current == '|' && !in_single_quotes && !in_double_quotes) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Strip a trailing background operator
+ *
+ * Scans the line with full quote/escape state and, if the last
+ * non-blank character is an unquoted '&', removes it from the buffer.
+ *
+ * @param input Command string to scan (will be modified)
+ * @return int 1 if a background operator was stripped, 0 otherwise
+ */
+int strip_background_operator(char *input) {
+    if (!input) return 0;
+
+    int in_single_quotes = 0;
+    int in_double_quotes = 0;
+    char *amp = NULL;  // Last unquoted '&' seen
+
+    for (char *current = input; *current != '\0'; current++) {
+        if (*current == '\\' && !in_single_quotes) {
+            if (*(current + 1) != '\0') current++;
+            amp = NULL;
+        } else if (*current == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+            amp = NULL;
+        } else if (*current == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+            amp = NULL;
+        } else if (*current == '&' && !in_single_quotes && !in_double_quotes) {
+            amp = current;
+        } else if (*current != ' ' && *current != '\t') {
+            // Any later non-blank character means the '&' was not trailing
+            amp = NULL;
+        }
+    }
+
+    if (amp) {
+        *amp = '\0';
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Split a command line at chain operators
+ *
+ * One quote/escape-aware scan splits the input at unquoted ';',
+ * '&&', and '||' operators. Each operator position is overwritten
+ * with NUL so the segments are plain C strings into the input
+ * buffer; the segment and operator arrays come from the arena.
+ *
+ * @param input Input string to split (will be modified)
+ * @param chain Pointer to CommandChain structure to fill
+ * @return int 0 on success, non-zero on error
+ */
+int parse_command_chain(char *input, CommandChain *chain) {
+    if (!input || !chain) return -1;
+
+    // Count segments first so the arrays can be sized exactly
+    int in_single_quotes = 0;
+    int in_double_quotes = 0;
+    int num_segments = 1;
+
+    for (char *current = input; *current != '\0'; current++) {
+        // Skip ahead to the next quote, escape, or operator byte
+        current = (char *)scan_skip(current,
+                                    in_single_quotes ? SCAN_SQ
+                                    : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                                    : (SCAN_ESC | SCAN_SQ | SCAN_DQ |
+                                       SCAN_PIPE | SCAN_CHAIN));
+        if (*current == '\0') break;
+
+        if (*current == '\\' && !in_single_quotes) {
+            if (*(current + 1) != '\0') current++;
+        } else if (*current == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+        } else if (*current == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+        } else if (!in_single_quotes && !in_double_quotes) {
+            if (*current == ';') {
+                num_segments++;
+            } else if ((*current == '&' && *(current + 1) == '&') ||
+                       (*current == '|' && *(current + 1) == '|')) {
+                num_segments++;
+                current++;
+            }
+        }
+    }
+
+    chain->segments = arena_alloc(num_segments * sizeof(char*));
+    chain->operators = arena_alloc(num_segments * sizeof(ChainOperator));
+    if (!chain->segments || !chain->operators) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    // Second pass: cut the line at the operators
+    in_single_quotes = 0;
+    in_double_quotes = 0;
+    chain->num_segments = 0;
+    chain->segments[0] = input;
+    chain->operators[0] = CHAIN_SEQ;
+
+    for (char *current = input; ; current++) {
+        ChainOperator op;
+        char *next_segment;
+
+        // Same skip as the counting pass; NUL stops it
+        current = (char *)scan_skip(current,
+                                    in_single_quotes ? SCAN_SQ
+                                    : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                                    : (SCAN_ESC | SCAN_SQ | SCAN_DQ |
+                                       SCAN_PIPE | SCAN_CHAIN));
+
+        if (*current == '\0') {
+            chain->num_segments++;
+            break;
+        } else if (*current == '\\' && !in_single_quotes) {
+            if (*(current + 1) != '\0') current++;
+            continue;
+        } else if (*current == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+            continue;
+        } else if (*current == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+            continue;
+        } else if (in_single_quotes || in_double_quotes) {
+            continue;
+        } else if (*current == ';') {
+            op = CHAIN_SEQ;
+            next_segment = current + 1;
+        } else if (*current == '&' && *(current + 1) == '&') {
+            op = CHAIN_AND;
+            next_segment = current + 2;
+        } else if (*current == '|' && *(current + 1) == '|') {
+            op = CHAIN_OR;
+            next_segment = current + 2;
+        } else {
+            continue;
+        }
+
+        *current = '\0';
+        chain->num_segments++;
+        chain->segments[chain->num_segments] = next_segment;
+        chain->operators[chain->num_segments] = op;
+        current = next_segment - 1;
+    }
+
+    // '&&'/'||' with nothing after them is a syntax error; a trailing
+    // ';' just leaves a harmless empty segment
+    for (int i = 1; i < chain->num_segments; i++) {
+        if (chain->operators[i] != CHAIN_SEQ) {
+            const char *s = chain->segments[i];
+            while (*s == ' ' || *s == '\t') s++;
+            if (*s == '\0') {
+                ERROR_ERROR(ERR_SYNTAX, "Syntax error near unexpected token '%s'",
+                            chain->operators[i] == CHAIN_AND ? "&&" : "||");
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Parse a command line into a pipeline
+ * 
+ * Splits the input at unquoted '|' operators and parses each stage
+ * into a Command (including its redirections).
+ * 
+ * @param input Input string to parse (will be modified)
+ * @param pipeline Pointer to Pipeline structure to fill
+ * @return int 0 on success, non-zero on error
+ */
+int parse_pipeline(char *input, Pipeline *pipeline) {
+    if (!input || !pipeline) return -1;
+    
+    pipeline->commands = NULL;
+    pipeline->num_commands = 0;
+    
+    // Count the stages by scanning for unquoted pipes
+    int num_stages = 1;
+    int in_single_quotes = 0;
+    int in_double_quotes = 0;
+    
+    for (char *current = input; *current != '\0'; current++) {
+        // Skip ahead to the next quote, escape, or candidate pipe
+        current = (char *)scan_skip(current,
+                                    in_single_quotes ? SCAN_SQ
+                                    : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                                    : (SCAN_ESC | SCAN_SQ | SCAN_DQ | SCAN_PIPE));
+        if (*current == '\0') break;
+
+        if (*current == '\\' && !in_single_quotes) {
+            if (*(current + 1) != '\0') current++;
+        } else if (*current == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+        } else if (*current == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+        } else if (*current == '|' && !in_single_quotes && !in_double_quotes) {
+            num_stages++;
+        }
+    }
+    
+    if (in_single_quotes || in_double_quotes) {
+        ERROR_ERROR(ERR_SYNTAX, "Unclosed quotes in command");
+        return -1;
+    }
+    
+    pipeline->commands = arena_alloc(num_stages * sizeof(Command));
+    if (!pipeline->commands) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+    memset(pipeline->commands, 0, num_stages * sizeof(Command));
+    
+    // Split the input in place at each unquoted pipe
+    char *stage_start = input;
+    char *current = input;
+    int done = 0;
+    
+    while (!done) {
+        // Same skip as the counting pass; NUL stops it
+        current = (char *)scan_skip(current,
+                                    in_single_quotes ? SCAN_SQ
+                                    : in_double_quotes ? (SCAN_ESC | SCAN_DQ)
+                                    : (SCAN_ESC | SCAN_SQ | SCAN_DQ | SCAN_PIPE));
+
+        if (*current == '\\' && !in_single_quotes) {
+            if (*(current + 1) != '\0') current++;
+        } else if (*current == '\'' && !in_double_quotes) {
+            in_single_quotes = !in_single_quotes;
+        } else if (*current == '"' && !in_single_quotes) {
+            in_double_quotes = !in_double_quotes;
+        }
+        
+        if (*current == '\0' ||
+            (*current == '|' && !in_single_quotes && !in_double_quotes)) {
+            done = (*current == '\0');
+            *current = '\0';
+            
+            // Tokenize this stage (arguments and redirections) in one pass
+            Command *cmd = &pipeline->commands[pipeline->num_commands];
+            initialize_redirection_info(&cmd->redir);
+
+            if (parse_command_line(stage_start, cmd) != 0) {
+                pipeline->num_commands++;
+                free_pipeline(pipeline);
+                return -1;
+            }
+            
+            pipeline->num_commands++;
+            
+            // An empty stage (e.g. "ls ||" or "| ls") is a syntax error
+            if (cmd->argc == 0) {
+                ERROR_ERROR(ERR_SYNTAX, "Syntax error near unexpected token '|'");
+                free_pipeline(pipeline);
+                return -1;
+            }
+            
+            stage_start = current + 1;
+        }
+        
+        if (!done) current++;
+    }
+    
+    return 0;
+}
@@ -11,31 +11,51 @@
 #include "command/executor.h"
 #include "command/redirection.h"
 #include "utils/error.h"
+#include "utils/memory.h"
+#include "utils/output.h"
 #include "utils/string.h"
+#include "utils/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
 /**
- * @brief Process a command
- * 
- * Main function to process a command: parses the input, sets up redirections,
- * and executes the command.
- * 
- * @param input Command input string
+ * @brief Execute one chain segment
+ *
+ * Runs a single command or pipeline (one segment of a command
+ * chain). Leaves the arena alone - process_command() resets it once
+ * after the whole chain has run.
+ *
+ * @param segment Segment string (arena memory, will be modified)
  * @return int Status code from command execution
  */
-int process_command(char *input) {
-    if (input == NULL || *input == '\0') {
-        return 0;
-    }
+static int run_chain_segment(char *segment) {
+    // A trailing unquoted '&' launches the command without waiting
+    int background = strip_background_operator(segment);
 
-    // Create a copy of input that we can modify
-    char *input_copy = strdup(input);
-    if (input_copy == NULL) {
-        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
-        return -1;
+    // Pipelines take a separate path: all stages are spawned
+    // concurrently and connected by pipes
+    if (contains_unquoted_pipe(segment)) {
+        Pipeline pipeline;
+
+        // parse_pipeline cuts the segment up in place, so copy the
+        // text first when the job table will need it
+        char *pipe_cmdline = background ? arena_strdup(segment) : NULL;
+
+        if (parse_pipeline(segment, &pipeline) != 0) {
+            ERROR_ERROR(ERR_PARSE, "Failed to parse pipeline");
+            return -1;
+        }
+
+        if (background) {
+            return execute_pipeline_background(&pipeline, pipe_cmdline);
+        }
+
+        long span = trace_begin();
+        int status = execute_pipeline(&pipeline);
+        trace_end(TRACE_PIPELINE, span);
+        return status;
     }
 
     // Initialize command structure
@@ -43,58 +63,113 @@ int process_command(char *input) {
     memset(&cmd, 0, sizeof(Command));
     initialize_redirection_info(&cmd.redir);
 
-    // Parse redirections and remove them from the command string
-    if (parse_redirections(input_copy, &cmd.redir) != 0) {
-        ERROR_ERROR(ERR_PARSE, "Failed to parse redirections");
-        free(input_copy);
-        free_redirection_info(&cmd.redir);
-        return -1;
-    }
+    // The tokenizer cuts the segment up in place, so keep a copy of
+    // the text for the job table when the command goes to background
+    char *cmdline = background ? arena_strdup(segment) : NULL;
+
+    // Tokenize the segment in a single pass: arguments and redirections
+    // come out of one scan, with argv pointing into the arena copy
+    long span = trace_begin();
+    int parse_result = parse_command_line(segment, &cmd);
+    trace_end(TRACE_TOKENIZE, span);
 
-    // Parse command and arguments
-    if (parse_command(input_copy, &cmd) != 0) {
+    if (parse_result != 0) {
         ERROR_ERROR(ERR_PARSE, "Failed to parse command");
-        free(input_copy);
-        free_command(&cmd);
         return -1;
     }
 
-    // Free the input copy as it's no longer needed
-    free(input_copy);
-
     // Skip if no command was found
     if (cmd.argc == 0) {
-        free_command(&cmd);
         return 0;
     }
 
-    // Setup file descriptor backups and new file descriptors
-    int backup_fds[2] = {-1, -1}; // stdout, stderr
-    int new_fds[2] = {-1, -1};    // stdout, stderr
+    span = trace_begin();
+    BuiltinFunc builtin = find_builtin(cmd.argv[0]);
+    trace_end(TRACE_BUILTIN_LOOKUP, span);
+
+    // Background jobs are launched without waiting; builtins run in
+    // the shell process, so '&' is ignored for them
+    if (background && !builtin) {
+        return execute_external_command_background(&cmd, cmdline);
+    }
+
+    // Built-ins run in the shell process, so their redirections must be
+    // applied here and restored afterwards. External commands get their
+    // redirections in the child, so the parent's descriptors stay put.
+    if (builtin) {
+        int backup_fds[2] = {-1, -1}; // stdout, stderr
+        int new_fds[2] = {-1, -1};    // stdout, stderr
+
+        if (setup_redirections(&cmd.redir, backup_fds, new_fds) != 0) {
+            ERROR_ERROR(ERR_IO, "Failed to set up redirections");
+            return -1;
+        }
+
+        span = trace_begin();
+        int status = builtin(&cmd);
+        trace_end(TRACE_BUILTIN_RUN, span);
+
+        // Drain the buffered output while fd 1 still points at the
+        // redirection target: one write(2) per command
+        out_flush();
+
+        restore_redirections(backup_fds, new_fds);
+        return status;
+    }
+
+    return execute_external_command(&cmd);
+}
 
-    // Set up redirections
-    if (setup_redirections(&cmd.redir, backup_fds, new_fds) != 0) {
-        ERROR_ERROR(ERR_IO, "Failed to set up redirections");
-        free_command(&cmd);
+/**
+ * @brief Process a command
+ *
+ * Main function to process a command line: splits it at chain
+ * operators (';', '&&', '||') and executes the segments sequentially
+ * with short-circuit evaluation. All parse state lives in the command
+ * arena, which is reset in one shot before returning - there are no
+ * per-argument frees on this path.
+ *
+ * @param input Command input string
+ * @return int Status code from command execution
+ */
+int process_command(char *input) {
+    if (input == NULL || *input == '\0') {
+        return 0;
+    }
+
+    // Create a copy of input that we can modify
+    char *input_copy = arena_strdup(input);
+    if (input_copy == NULL) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    // Split at ';', '&&', and '||' before anything else looks at
+    // the line; a plain command is just a one-segment chain
+    CommandChain chain;
+    long span = trace_begin();
+    int chain_result = parse_command_chain(input_copy, &chain);
+    trace_end(TRACE_PARSE_CHAIN, span);
+
+    if (chain_result != 0) {
+        arena_reset();
         return -1;
     }
 
     int status = 0;
 
-    // Try to execute as a built-in command first
-    if (!execute_builtin_command(&cmd)) {
-        // If not a built-in, try as external command
-        status = execute_external_command(&cmd);
-        if (status < 0) {
-            ERROR_ERROR(ERR_NOT_FOUND, "Command not found: %s", cmd.argv[0]);
+    for (int i = 0; i < chain.num_segments; i++) {
+        // Short-circuit: '&&' runs on success, '||' on failure
+        if (i > 0) {
+            if (chain.operators[i] == CHAIN_AND && status != 0) continue;
+            if (chain.operators[i] == CHAIN_OR && status == 0) continue;
         }
-    }
 
-    // Restore original stdout/stderr
-    restore_redirections(backup_fds, new_fds);
+        status = run_chain_segment(chain.segments[i]);
+    }
 
-    // Clean up command resources
-    free_command(&cmd);
+    // Reclaim all parse state in one shot
+    arena_reset();
 
     return status;
 }
@@ -116,42 +191,59 @@ void initialize_redirection_info(RedirectionInfo *redir) {
 }
 
 /**
- * @brief Free resources used by redirection info
- * 
- * Frees memory allocated for a RedirectionInfo structure.
- * 
+ * @brief Release a redirection info structure
+ *
+ * The filenames live in the command arena, so there is nothing to
+ * free() - this just clears the pointers. The storage itself is
+ * reclaimed by arena_reset().
+ *
  * @param redir Pointer to RedirectionInfo structure
  */
 void free_redirection_info(RedirectionInfo *redir) {
     if (redir) {
-        if (redir->stdout_file) free(redir->stdout_file);
-        if (redir->stderr_file) free(redir->stderr_file);
         redir->stdout_file = NULL;
         redir->stderr_file = NULL;
     }
 }
 
 /**
- * @brief Free resources used by command structure
- * 
- * Frees memory allocated for a Command structure.
- * 
+ * @brief Release a command structure
+ *
+ * The argv array and its strings live in the command arena, so there
+ * is nothing to free() - this just clears the fields. The storage
+ * itself is reclaimed by arena_reset().
+ *
  * @param cmd Pointer to Command structure
  */
 void free_command(Command *cmd) {
     if (cmd) {
-        if (cmd->argv) {
-            for (int i = 0; i < cmd->argc; i++) {
-                if (cmd->argv[i]) free(cmd->argv[i]);
-            }
-            free(cmd->argv);
-            cmd->argv = NULL;
-        }
+        cmd->argv = NULL;
         cmd->argc = 0;
         free_redirection_info(&cmd->redir);
     }
 }
 
+/**
+ * @brief Release a pipeline structure
+ *
+ * The stage array lives in the command arena, so there is nothing to
+ * free() - this just clears the fields. The storage itself is
+ * reclaimed by arena_reset().
+ *
+ * @param pipeline Pointer to Pipeline structure
+ */
+void free_pipeline(Pipeline *pipeline) {
+    if (pipeline) {
+        if (pipeline->commands) {
+            for (int i = 0; i < pipeline->num_commands; i++) {
+                free_command(&pipeline->commands[i]);
+            }
+            pipeline->commands = NULL;
+        }
+        pipeline->num_commands = 0;
+    }
+}
+
 /**
  * @brief Set up redirections before command execution
  * 
@@ -181,24 +273,28 @@ int setup_redirections(RedirectionInfo *redir, int *backup_fds, int *new_fds) {
         } else {
             file_flags |= O_TRUNC;   // Overwrite file
         }
-        new_fds[0] = open(redir->stdout_file, file_flags, 0644);
-        
+        int cached = 0;
+        new_fds[0] = redir_fd_get(redir->stdout_file, file_flags, &cached);
+
         if (new_fds[0] == -1) {
             ERROR_SYSTEM(ERR_IO, "Failed to open stdout file: %s", redir->stdout_file);
             close(backup_fds[0]);
             backup_fds[0] = -1;
             return -1;
         }
-        
+
         // Redirect stdout to the file
         if (dup2(new_fds[0], STDOUT_FILENO) == -1) {
             ERROR_SYSTEM(ERR_IO, "dup2 failed for stdout");
-            close(new_fds[0]);
+            if (!cached) close(new_fds[0]);
             close(backup_fds[0]);
             new_fds[0] = -1;
             backup_fds[0] = -1;
             return -1;
         }
+
+        // A cached fd belongs to the cache; restore must not close it
+        if (cached) new_fds[0] = -1;
     }
     
     // Set up redirection for stderr if needed
@@ -226,8 +322,9 @@ int setup_redirections(RedirectionInfo *redir, int *backup_fds, int *new_fds) {
         } else {
             file_flags |= O_TRUNC;   // Overwrite file
         }
-        new_fds[1] = open(redir->stderr_file, file_flags, 0644);
-        
+        int cached = 0;
+        new_fds[1] = redir_fd_get(redir->stderr_file, file_flags, &cached);
+
         if (new_fds[1] == -1) {
             ERROR_SYSTEM(ERR_IO, "Failed to open stderr file: %s", redir->stderr_file);
             close(backup_fds[1]);
@@ -247,7 +344,7 @@ int setup_redirections(RedirectionInfo *redir, int *backup_fds, int *new_fds) {
         // Redirect stderr to the file
         if (dup2(new_fds[1], STDERR_FILENO) == -1) {
             ERROR_SYSTEM(ERR_IO, "dup2 failed for stderr");
-            close(new_fds[1]);
+            if (!cached) close(new_fds[1]);
             close(backup_fds[1]);
             new_fds[1] = -1;
             backup_fds[1] = -1;
@@ -262,8 +359,11 @@ int setup_redirections(RedirectionInfo *redir, int *backup_fds, int *new_fds) {
             }
             return -1;
         }
+
+        // A cached fd belongs to the cache; restore must not close it
+        if (cached) new_fds[1] = -1;
     }
-    
+
     return 0;
 }
 
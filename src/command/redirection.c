@@ -0,0 +1,110 @@
+/**
+ * @file redirection.c
+ * @brief Redirection fd cache implementation
+ *
+ * Small LRU of open append-mode file descriptors keyed by
+ * (path, flags). Every redirected command used to pay an open+close
+ * on its target; a batch loop appending thousands of lines to the
+ * same log now reuses one fd for the whole session. Only O_APPEND
+ * opens are cached - the kernel serializes the write position for
+ * those, so sharing the fd is indistinguishable from reopening.
+ */
+
+#include "command/redirection.h"
+#include "utils/error.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief One cached append-mode fd
+ */
+typedef struct {
+    char *path;      /**< Target filename (owned), NULL if empty */
+    int flags;       /**< open() flags the fd was created with */
+    int fd;          /**< The open descriptor */
+    long last_used;  /**< LRU stamp */
+} RedirFdSlot;
+
+static RedirFdSlot cache[REDIR_FD_CACHE_SLOTS];
+static long use_counter = 0;
+
+/**
+ * @brief Open a redirection target, reusing cached append fds
+ *
+ * @param path Target filename
+ * @param flags open() flags
+ * @param cached Out: set non-zero when the returned fd is owned by
+ *               the cache and must not be closed by the caller
+ * @return int Open file descriptor, -1 on error
+ */
+int redir_fd_get(const char *path, int flags, int *cached) {
+    if (cached) *cached = 0;
+    if (!path) return -1;
+
+    // Truncating opens must really reopen: O_TRUNC is the point
+    if (!(flags & O_APPEND)) {
+        return open(path, flags, 0644);
+    }
+
+    // One pass finds a hit, an empty slot, and the LRU victim
+    RedirFdSlot *empty = NULL;
+    RedirFdSlot *victim = &cache[0];
+    for (int i = 0; i < REDIR_FD_CACHE_SLOTS; i++) {
+        RedirFdSlot *slot = &cache[i];
+        if (slot->path == NULL) {
+            if (!empty) empty = slot;
+            continue;
+        }
+        if (slot->flags == flags && strcmp(slot->path, path) == 0) {
+            slot->last_used = ++use_counter;
+            if (cached) *cached = 1;
+            return slot->fd;
+        }
+        if (slot->last_used < victim->last_used) {
+            victim = slot;
+        }
+    }
+
+    // Miss: open with O_CLOEXEC so the cached fd never leaks into
+    // children (the dup2 copy the command writes through loses the
+    // flag, as dup2 always does)
+    int fd = open(path, flags | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        return -1;
+    }
+
+    RedirFdSlot *slot = empty ? empty : victim;
+    if (slot->path != NULL) {
+        close(slot->fd);
+        free(slot->path);
+        slot->path = NULL;
+    }
+
+    slot->path = strdup(path);
+    if (!slot->path) {
+        // Cache entry failed; hand the fd to the caller uncached
+        return fd;
+    }
+
+    slot->flags = flags;
+    slot->fd = fd;
+    slot->last_used = ++use_counter;
+    if (cached) *cached = 1;
+    return fd;
+}
+
+/**
+ * @brief Close all cached redirection fds
+ */
+void redir_fd_cache_destroy(void) {
+    for (int i = 0; i < REDIR_FD_CACHE_SLOTS; i++) {
+        if (cache[i].path != NULL) {
+            close(cache[i].fd);
+            free(cache[i].path);
+            cache[i].path = NULL;
+        }
+    }
+    use_counter = 0;
+}
@@ -5,6 +5,7 @@
  * Implementation of terminal handling functions.
  */
 
+#include "shell.h"
 #include "terminal/terminal.h"
 #include "terminal/input.h"
 #include "utils/error.h"
@@ -13,12 +14,37 @@
 #include <string.h>
 #include <unistd.h>
 #include <termios.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 
 /** Original terminal attributes */
 static struct termios orig_termios;
 static int raw_mode_enabled = 0;
 
+/** Input buffer size */
+#define INPUT_BUF_SIZE 4096
+
+/** Buffered input: bytes read but not yet consumed */
+static char input_buf[INPUT_BUF_SIZE];
+static int input_buf_pos = 0;
+static int input_buf_len = 0;
+
+/** Maximum tracked line length for incremental redraw */
+#define PAINT_BUF_SIZE 4096
+
+/** Last-painted line state for diff-based redraw */
+static char painted_line[PAINT_BUF_SIZE];
+static int painted_len = 0;
+static int painted_cursor = 0;
+static int painted_prompt_len = 0;  /**< Visible prompt width in columns */
+static int paint_valid = 0;         /**< Screen matches the tracked state */
+
+/** Rendered prompt cache: cwd plus color escapes and "$ " */
+#define PROMPT_BUF_SIZE 1100
+static char prompt_text[PROMPT_BUF_SIZE];
+static int prompt_visible_len = 0;
+static int prompt_cached = 0;
+
 /**
  * @brief Initialize terminal settings
  * 
@@ -91,7 +117,13 @@ void enable_raw_mode(void) {
         ERROR_SYSTEM(ERR_SYSTEM, "Failed to set terminal attributes");
         return;
     }
-    
+
+    // Ask the terminal to bracket pastes (ESC[200~ ... ESC[201~), so
+    // the line editor can take a paste as one block instead of
+    // processing it key by key
+    fputs("\033[?2004h", stdout);
+    fflush(stdout);
+
     raw_mode_enabled = 1;
 }
 
@@ -104,7 +136,11 @@ void disable_raw_mode(void) {
     if (!raw_mode_enabled) {
         return;  // Not in raw mode
     }
-    
+
+    // Turn bracketed paste back off before leaving raw mode
+    fputs("\033[?2004l", stdout);
+    fflush(stdout);
+
     if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &orig_termios) < 0) {
         ERROR_SYSTEM(ERR_SYSTEM, "Failed to restore terminal attributes");
     }
@@ -114,64 +150,104 @@ void disable_raw_mode(void) {
 
 /**
  * @brief Read a character from terminal
- * 
- * Reads a single character from the terminal.
- * 
+ *
+ * Reads a single character through the input buffer. When the buffer
+ * runs dry, one read(2) refills it with everything currently
+ * available (VMIN=1 blocks only until the first byte), so a paste or
+ * an escape sequence is consumed with a single syscall.
+ *
  * @return int Character read, or -1 on error
  */
 int read_char(void) {
-    char c;
-    if (read(STDIN_FILENO, &c, 1) != 1) {
-        return -1;
+    if (input_buf_pos >= input_buf_len) {
+        ssize_t n = read(STDIN_FILENO, input_buf, INPUT_BUF_SIZE);
+        if (n <= 0) {
+            return -1;
+        }
+        input_buf_len = (int)n;
+        input_buf_pos = 0;
     }
-    return (int)c;
+
+    return (unsigned char)input_buf[input_buf_pos++];
 }
 
 /**
- * @brief Read a line from terminal
- * 
- * Reads a line of input with editing capabilities.
- * 
- * @param buffer Buffer to store the input
- * @param size Buffer size
- * @return int Number of characters read, or -1 on error
+ * @brief Peek at the next buffered character
+ *
+ * Returns the next character without consuming it. Only looks at the
+ * userspace buffer - never blocks or issues a read(2).
+ *
+ * @return int Next character, or -1 if the buffer is empty
  */
-int read_line(char *buffer, int size) {
-    if (!buffer || size <= 0) {
+int peek_char(void) {
+    if (input_buf_pos >= input_buf_len) {
         return -1;
     }
-    
+
+    return (unsigned char)input_buf[input_buf_pos];
+}
+
+/**
+ * @brief Check whether input is pending
+ *
+ * Returns non-zero if a character can be read without blocking,
+ * either from the input buffer or from the terminal itself.
+ *
+ * @return int 1 if input is pending, 0 otherwise
+ */
+int input_pending(void) {
+    if (input_buf_pos < input_buf_len) {
+        return 1;
+    }
+
+    struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+    return poll(&pfd, 1, 0) > 0;
+}
+
+/**
+ * @brief Read a line from terminal
+ *
+ * Reads a line of input with editing capabilities. The returned line
+ * is the editor's own heap buffer handed through unclipped, so there
+ * is no fixed-size truncation point anywhere on the input path - a
+ * pasted line longer than the initial allocation just grows it.
+ *
+ * @return char* The line read (caller must free), NULL on EOF or error
+ */
+char *read_line(void) {
     LineState ls;
-    
-    // Initialize line state
-    if (line_state_init(&ls, size) != 0) {
-        return -1;
+
+    // Initialize line state; this is only the starting allocation -
+    // the editor grows it by doubling as needed
+    if (line_state_init(&ls, INPUT_BUFFER_SIZE) != 0) {
+        return NULL;
     }
-    
+
     // Enable raw mode for reading
     int orig_raw_mode = raw_mode_enabled;
     if (!raw_mode_enabled) {
         enable_raw_mode();
     }
-    
+
     // Read edited line
     int result = read_edited_line(&ls);
-    
-    // Copy the result to the buffer
+
+    // Hand the editor's buffer through instead of copying it out
+    char *line = NULL;
     if (result >= 0) {
-        strncpy(buffer, ls.buffer, size - 1);
-        buffer[size - 1] = '\0';  // Ensure null termination
+        line = ls.buffer;
+        ls.buffer = NULL;
     }
-    
-    // Clean up line state
+
+    // Clean up line state (a no-op for the detached buffer)
     line_state_cleanup(&ls);
-    
+
     // Restore terminal mode if it wasn't in raw mode before
     if (!orig_raw_mode) {
         disable_raw_mode();
     }
-    
-    return result;
+
+    return line;
 }
 
 /**
@@ -183,6 +259,9 @@ void clear_screen(void) {
     // Use ANSI escape codes to clear screen and move cursor to home position
     printf("\033[2J\033[H");
     fflush(stdout);
+
+    // The tracked line is gone from the screen
+    refresh_line_invalidate();
 }
 
 /**
@@ -191,15 +270,39 @@ void clear_screen(void) {
  * Displays the shell prompt.
  */
 void display_prompt(void) {
-    // Get current working directory
-    char cwd[1024];
-    if (getcwd(cwd, sizeof(cwd)) == NULL) {
-        strcpy(cwd, "unknown");
+    // Re-render the prompt only when the working directory changed -
+    // getcwd can be milliseconds on automounted trees
+    if (!prompt_cached) {
+        char cwd[1024];
+        if (getcwd(cwd, sizeof(cwd)) == NULL) {
+            strcpy(cwd, "unknown");
+        }
+
+        snprintf(prompt_text, PROMPT_BUF_SIZE, "\033[1;32m%s\033[0m$ ", cwd);
+        prompt_visible_len = (int)strlen(cwd) + 2;  // cwd plus "$ "
+        prompt_cached = 1;
     }
-    
-    // Display prompt with current directory
-    printf("\033[1;32m%s\033[0m$ ", cwd);
+
+    // Display the cached prompt
+    fputs(prompt_text, stdout);
     fflush(stdout);
+
+    // A freshly painted prompt starts an empty tracked line
+    painted_prompt_len = prompt_visible_len;
+    painted_line[0] = '\0';
+    painted_len = 0;
+    painted_cursor = 0;
+    paint_valid = 1;
+}
+
+/**
+ * @brief Invalidate the cached prompt
+ *
+ * Forces the next display_prompt() to re-read the working directory.
+ * Called when the cd builtin actually changes directory.
+ */
+void prompt_invalidate(void) {
+    prompt_cached = 0;
 }
 
 /**
@@ -245,32 +348,101 @@ int get_terminal_size(int *rows, int *cols) {
     return 0;
 }
 
+/**
+ * @brief Move the terminal cursor to a line column
+ *
+ * Emits a carriage return plus a cursor-forward sequence. Column 0
+ * is the first prompt character.
+ *
+ * @param column Target column
+ */
+static void move_to_column(int column) {
+    if (column > 0) {
+        printf("\r\033[%dC", column);
+    } else {
+        printf("\r");
+    }
+}
+
+/**
+ * @brief Invalidate the tracked line state
+ *
+ * Forces the next refresh_line() to do a full repaint. Call after
+ * writing to the terminal outside the renderer (completion lists,
+ * search prompts, command output).
+ */
+void refresh_line_invalidate(void) {
+    paint_valid = 0;
+}
+
 /**
  * @brief Refresh the current line
- * 
- * Redraws the current input line.
- * 
+ *
+ * Incremental renderer: diffs the buffer against the last-painted
+ * state and emits only what changed - appending a character at the
+ * end of the line writes just that character, pure cursor motion
+ * writes one escape sequence. Output is staged in stdio's buffer and
+ * flushed once, so each event is a single write(2).
+ *
  * @param buffer Current input buffer
  * @param cursor Cursor position
  */
 void refresh_line(const char *buffer, int cursor) {
-    // Go to the beginning of the line
-    printf("\r");
-    
-    // Print the prompt
-    display_prompt();
-    
-    // Print the buffer
-    printf("%s", buffer);
-    
-    // Calculate cursor position
-    int prompt_len = 2; // $ plus space
-    int pos = prompt_len + cursor;
-    
-    // Move cursor to the correct position
-    printf("\r\033[%dC", pos);
-    
+    int len = (int)strlen(buffer);
+
+    // Full repaint when the tracked state is stale or the line is too
+    // long to track
+    if (!paint_valid || len >= PAINT_BUF_SIZE) {
+        printf("\r");
+        display_prompt();
+        printf("%s\033[K", buffer);
+        move_to_column(painted_prompt_len + cursor);
+        fflush(stdout);
+
+        if (len < PAINT_BUF_SIZE) {
+            memcpy(painted_line, buffer, len + 1);
+            painted_len = len;
+            painted_cursor = cursor;
+        } else {
+            paint_valid = 0;
+        }
+        return;
+    }
+
+    // Length of the unchanged prefix
+    int p = 0;
+    while (p < len && p < painted_len && buffer[p] == painted_line[p]) {
+        p++;
+    }
+
+    if (p == len && p == painted_len) {
+        // Text unchanged - at most the cursor moved
+        if (cursor != painted_cursor) {
+            move_to_column(painted_prompt_len + cursor);
+            fflush(stdout);
+            painted_cursor = cursor;
+        }
+        return;
+    }
+
+    // Fast path: appending at the end with the cursor following along
+    if (p == painted_len && painted_cursor == painted_len && cursor == len) {
+        fwrite(buffer + p, 1, len - p, stdout);
+    } else {
+        // Rewrite from the first difference, clear any leftover tail,
+        // then park the cursor
+        move_to_column(painted_prompt_len + p);
+        fwrite(buffer + p, 1, len - p, stdout);
+        if (len < painted_len) {
+            printf("\033[K");
+        }
+        move_to_column(painted_prompt_len + cursor);
+    }
     fflush(stdout);
+
+    memcpy(painted_line, buffer, len + 1);
+    painted_len = len;
+    painted_cursor = cursor;
 }
 
 /**
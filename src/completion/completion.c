@@ -6,9 +6,13 @@
  */
 
 #include "completion/completion.h"
+#include "completion/index.h"
 #include "completion/matcher.h"
 #include "builtins/builtins.h"
+#include "terminal/terminal.h"
+#include "utils/dircache.h"
 #include "utils/error.h"
+#include "utils/output.h"
 #include "utils/path.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,6 +27,267 @@
 static time_t last_tab_time = 0;
 static char last_tab_prefix[PATH_MAX] = "";
 
+// Reused across Tab presses: the pool allocation survives resets
+static CompletionSet tab_set;
+
+/**
+ * @brief Reset a completion set for reuse
+ *
+ * Clears the counters but keeps the pool allocation.
+ *
+ * @param set Set to reset
+ */
+void completion_set_reset(CompletionSet *set) {
+    if (!set) {
+        return;
+    }
+
+    set->pool_len = 0;
+    set->count = 0;
+    set->total = 0;
+    set->lcp[0] = '\0';
+    set->lcp_len = 0;
+}
+
+/**
+ * @brief Stream one match into a completion set
+ *
+ * Updates the total and the longest common prefix unconditionally;
+ * stores the name (plus a trailing slash for directories) only while
+ * under the cap.
+ *
+ * @param set Set to add to
+ * @param name Matching name
+ * @param is_dir Non-zero to append a trailing slash
+ * @return int 0 on success, non-zero on error
+ */
+int completion_set_add(CompletionSet *set, const char *name, int is_dir) {
+    if (!set || !name) {
+        return -1;
+    }
+
+    size_t name_len = strlen(name) + (is_dir ? 1 : 0);
+
+    // Maintain the longest common prefix incrementally - no need to
+    // keep the matches themselves around for it
+    if (set->total == 0) {
+        size_t copy_len = name_len < COMPLETION_LCP_MAX - 1
+                              ? name_len : COMPLETION_LCP_MAX - 1;
+        memcpy(set->lcp, name, is_dir ? copy_len - 1 : copy_len);
+        if (is_dir && copy_len > 0) {
+            set->lcp[copy_len - 1] = '/';
+        }
+        set->lcp[copy_len] = '\0';
+        set->lcp_len = (int)copy_len;
+    } else {
+        int j = 0;
+        while (j < set->lcp_len && name[j] != '\0' &&
+               name[j] == set->lcp[j]) {
+            j++;
+        }
+        set->lcp_len = j;
+        set->lcp[j] = '\0';
+    }
+    set->total++;
+
+    // Past the cap, matches are counted but not stored
+    if (set->count >= COMPLETION_SET_CAP) {
+        return 0;
+    }
+
+    // Pack the name into the pool; the allocation is reused across
+    // completion passes
+    size_t needed = set->pool_len + name_len + 1;
+    if (needed > set->pool_capacity) {
+        size_t new_capacity =
+            set->pool_capacity > 0 ? set->pool_capacity : 4096;
+        while (needed > new_capacity) {
+            new_capacity *= 2;
+        }
+        char *new_pool = realloc(set->pool, new_capacity);
+        if (!new_pool) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        set->pool = new_pool;
+        set->pool_capacity = new_capacity;
+    }
+
+    set->offsets[set->count] = set->pool_len;
+    memcpy(set->pool + set->pool_len, name, name_len - (is_dir ? 1 : 0));
+    if (is_dir) {
+        set->pool[set->pool_len + name_len - 1] = '/';
+    }
+    set->pool[set->pool_len + name_len] = '\0';
+    set->pool_len += name_len + 1;
+    set->count++;
+    return 0;
+}
+
+/**
+ * @brief Get a stored candidate by index
+ *
+ * @param set Completion set
+ * @param index Candidate index (0 .. count-1)
+ * @return const char* Candidate name, NULL if out of range
+ */
+const char *completion_set_get(const CompletionSet *set, int index) {
+    if (!set || index < 0 || index >= set->count) {
+        return NULL;
+    }
+    return set->pool + set->offsets[index];
+}
+
+/**
+ * @brief Collect completions for a prefix into a set
+ *
+ * Streaming replacement for get_all_completions(): command prefixes
+ * answer from the executable index, paths and arguments from the
+ * shared directory-listing cache, all through completion_set_add().
+ *
+ * @param prefix Prefix to complete
+ * @param is_command Non-zero if the prefix is the command word
+ * @param set Set to fill (reset first)
+ * @return int 0 on success, non-zero on error
+ */
+int completion_stream_collect(const char *prefix, int is_command,
+                              CompletionSet *set) {
+    if (!prefix || !set) {
+        return -1;
+    }
+
+    completion_set_reset(set);
+
+    // Command completion answers straight from the in-memory index
+    if (is_command && strchr(prefix, '/') == NULL) {
+        int num_matches = 0;
+        char **matches = completion_index_lookup(prefix, &num_matches);
+        if (matches) {
+            for (int i = 0; i < num_matches; i++) {
+                completion_set_add(set, matches[i], 0);
+                free(matches[i]);
+            }
+            free(matches);
+        }
+        return 0;
+    }
+
+    // Path or argument completion: split off the directory part
+    const char *dir_path = ".";
+    const char *file_prefix = prefix;
+    char dir_buf[PATH_MAX];
+    const char *last_slash = strrchr(prefix, '/');
+
+    if (last_slash) {
+        if (last_slash == prefix) {
+            dir_path = "/";
+        } else {
+            size_t dir_len = (size_t)(last_slash - prefix);
+            if (dir_len >= PATH_MAX) {
+                return -1;
+            }
+            memcpy(dir_buf, prefix, dir_len);
+            dir_buf[dir_len] = '\0';
+            dir_path = dir_buf;
+        }
+        file_prefix = last_slash + 1;
+    }
+
+    // Stream matches straight off the cached listing - entries come
+    // pre-sorted, so candidates land in order without a qsort
+    int entry_count = 0;
+    const DirCacheEntry *entries = dir_cache_get(dir_path, &entry_count);
+    if (!entries) {
+        return -1;
+    }
+
+    for (int i = 0; i < entry_count; i++) {
+        const char *name = entries[i].name;
+
+        // Skip . and .. unless specifically requested
+        if (strcmp(file_prefix, ".") != 0 && strcmp(file_prefix, "..") != 0) {
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+                continue;
+            }
+        }
+
+        if (prefix_match(name, file_prefix)) {
+            completion_set_add(set, name, entries[i].is_dir);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Display stored candidates a page at a time
+ *
+ * Prints the set's candidates in columns, pausing every screenful
+ * with a --More-- prompt (space or enter continues, anything else
+ * stops). Matches past the storage cap are summarized by count
+ * instead of being materialized.
+ *
+ * @param set Completion set
+ * @param input Current input line, reprinted after the listing
+ */
+static void display_completion_set(const CompletionSet *set,
+                                   const char *input) {
+    int rows, cols;
+    if (get_terminal_size(&rows, &cols) != 0) {
+        rows = 24;
+        cols = 80;
+    }
+    if (rows < 4) {
+        rows = 4;
+    }
+
+    // Column width from the widest stored candidate
+    int max_width = 0;
+    for (int i = 0; i < set->count; i++) {
+        int len = (int)strlen(completion_set_get(set, i));
+        if (len > max_width) {
+            max_width = len;
+        }
+    }
+    max_width += 2;
+
+    int num_cols = cols / max_width;
+    if (num_cols == 0) {
+        num_cols = 1;
+    }
+
+    int page_rows = rows - 2;  // Leave room for the prompt lines
+    int printed_rows = 0;
+    int stop = 0;
+
+    out_putc('\n');
+    for (int i = 0; i < set->count && !stop; ) {
+        for (int col = 0; col < num_cols && i < set->count; col++, i++) {
+            out_printf("%-*s", max_width, completion_set_get(set, i));
+        }
+        out_putc('\n');
+
+        if (++printed_rows >= page_rows && i < set->count) {
+            // Page break: drain the page with one write, then wait
+            // for a key before continuing
+            out_printf("--More--");
+            out_flush();
+            int c = read_char();
+            out_printf("\r\033[K");
+            if (c != ' ' && c != '\n' && c != '\r') {
+                stop = 1;
+            }
+            printed_rows = 0;
+        }
+    }
+
+    if (set->total > set->count) {
+        out_printf("(%d more matches not shown)\n", set->total - set->count);
+    }
+
+    out_printf("$ %s", input);
+    out_flush();
+}
+
 /**
  * @brief Handle tab completion
  * 
@@ -49,32 +314,38 @@ void handle_tab_completion(char *input, int *cursor_pos) {
             last_word = space + 1;
         }
         
-        // Get list of possible completions
-        char **completions = NULL;
-        int num_completions = 0;
-        
-        // Get completions
-        get_all_completions(last_word, &completions, &num_completions);
-        
+        // The first word on the line completes as a command, anything
+        // after it as a filename
+        int is_command = (last_word == prefix);
+
+        // Stream completions into the reusable set: capped storage,
+        // incremental longest-common-prefix, no per-entry malloc
+        completion_stream_collect(last_word, is_command, &tab_set);
+        int num_completions = tab_set.total;
+
         if (num_completions == 0) {
             printf("\a");  // Ring the bell
             fflush(stdout);
         } 
         else if (num_completions == 1) {
+            const char *completion = completion_set_get(&tab_set, 0);
+
             // Create the new input by replacing the last word with the completion
             char new_input[PATH_MAX] = {0};
-            
+
             // Copy everything before the last word
             int prefix_length = last_word - prefix;
             if (prefix_length > 0) {
                 strncpy(new_input, prefix, prefix_length);
             }
-            
+
             // Append the completion
-            strcat(new_input, completions[0]);
-            
-            // Add a space after the command if it's not a directory
-            if (!is_directory(completions[0])) {
+            strcat(new_input, completion);
+
+            // Add a space after the completion; directories already
+            // carry their trailing slash
+            size_t completion_len = strlen(completion);
+            if (completion_len == 0 || completion[completion_len - 1] != '/') {
                 strcat(new_input, " ");
             }
             
@@ -108,31 +379,21 @@ void handle_tab_completion(char *input, int *cursor_pos) {
             last_tab_prefix[0] = '\0';
         } 
         else {
-            if (current_time - last_tab_time <= 1 && 
+            if (current_time - last_tab_time <= 1 &&
                 strcmp(last_tab_prefix, last_word) == 0) {
-                // Second tab press within 1 second - show all completions
-                printf("\n");
-                
-                // Print all completions with two spaces between each
-                for (int i = 0; i < num_completions; i++) {
-                    printf("%s", completions[i]);
-                    if (i < num_completions - 1) {
-                        printf("  ");  // Two spaces between completions
-                    }
-                }
-                
-                // Print a new prompt
-                printf("\n$ %s", input);
-                fflush(stdout);
-                
+                // Second tab press within 1 second - page through the
+                // stored candidates instead of materializing them all
+                display_completion_set(&tab_set, input);
+
                 // Reset tab state
                 last_tab_time = 0;
                 last_tab_prefix[0] = '\0';
             } else {
-                // Find the longest common prefix among the completions
-                char *lcp = find_longest_common_prefix(completions, num_completions);
-                
-                if (lcp && strlen(lcp) > strlen(last_word)) {
+                // The longest common prefix was maintained while
+                // streaming - no second pass over the matches
+                const char *lcp = tab_set.lcp;
+
+                if ((size_t)tab_set.lcp_len > strlen(last_word)) {
                     // Create the new input by replacing the last word with the LCP
                     char new_input[PATH_MAX] = {0};
                     
@@ -171,53 +432,53 @@ void handle_tab_completion(char *input, int *cursor_pos) {
                     fflush(stdout);
                 }
                 
-                // Free the longest common prefix
-                if (lcp) free(lcp);
-                
                 // Store tab state for next time
                 last_tab_time = current_time;
                 strcpy(last_tab_prefix, last_word);
             }
         }
-        
-        // Free completions
-        if (completions) {
-            for (int i = 0; i < num_completions; i++) {
-                free(completions[i]);
-            }
-            free(completions);
-        }
     }
 }
 
 /**
  * @brief Get all possible completions
- * 
- * Find all possible completions for a given prefix.
- * 
+ *
+ * Find all possible completions for a given prefix. Command
+ * completions come from the prebuilt executable index; path and
+ * argument completions scan the relevant directory.
+ *
  * @param prefix Prefix to complete
+ * @param is_command Non-zero if the prefix is the command word
  * @param completions_ptr Pointer to store completions array
  * @param num_completions_ptr Pointer to store number of completions
  */
-void get_all_completions(const char *prefix, char ***completions_ptr, int *num_completions_ptr) {
+void get_all_completions(const char *prefix, int is_command,
+                         char ***completions_ptr, int *num_completions_ptr) {
     if (!prefix || !completions_ptr || !num_completions_ptr) return;
-    
+
     // Initialize output parameters
     *completions_ptr = NULL;
     *num_completions_ptr = 0;
-    
+
+    // Command completion answers straight from the in-memory index -
+    // no opendir/readdir on the Tab path
+    if (is_command && strchr(prefix, '/') == NULL) {
+        *completions_ptr = completion_index_lookup(prefix, num_completions_ptr);
+        return;
+    }
+
     // Array to store completions
     char **completions = NULL;
     int capacity = 10;  // Initial capacity
     int count = 0;
-    
+
     // Allocate initial array
     completions = malloc(capacity * sizeof(char*));
     if (!completions) {
         ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
         return;
     }
-    
+
     // Check if the prefix contains a slash - if so, it's a path
     if (strchr(prefix, '/') != NULL) {
         // Path completion
@@ -240,101 +501,8 @@ void get_all_completions(const char *prefix, char ***completions_ptr, int *num_c
         // Get completions from directory
         get_directory_completions(dir_path, file_prefix, &completions, &count);
     } else {
-        // Check if we're completing the first word (command) or an argument
-        if (prefix == extract_last_word(prefix)) {
-            // First word - command completion
-            // Check built-in commands
-            const BuiltinCommand *builtins = get_builtin_commands();
-            for (int i = 0; builtins[i].name != NULL; i++) {
-                if (prefix_match(builtins[i].name, prefix)) {
-                    // Add to completions array (resize if needed)
-                    if (count >= capacity) {
-                        capacity *= 2;
-                        char **new_completions = realloc(completions, capacity * sizeof(char*));
-                        if (!new_completions) {
-                            // Free existing completions on error
-                            for (int j = 0; j < count; j++) {
-                                free(completions[j]);
-                            }
-                            free(completions);
-                            *completions_ptr = NULL;
-                            *num_completions_ptr = 0;
-                            return;
-                        }
-                        completions = new_completions;
-                    }
-                    
-                    completions[count] = strdup(builtins[i].name);
-                    if (completions[count]) {
-                        count++;
-                    }
-                }
-            }
-            
-            // Check PATH for executables
-            char *path_env = getenv("PATH");
-            if (path_env) {
-                char *path_copy = strdup(path_env);
-                if (path_copy) {
-                    char *path = strtok(path_copy, ":");
-                    
-                    while (path != NULL) {
-                        DIR *dir = opendir(path);
-                        if (dir) {
-                            struct dirent *entry;
-                            while ((entry = readdir(dir)) != NULL) {
-                                if (prefix_match(entry->d_name, prefix)) {
-                                    char full_path[PATH_MAX];
-                                    snprintf(full_path, PATH_MAX, "%s/%s", path, entry->d_name);
-                                    
-                                    struct stat st;
-                                    if (stat(full_path, &st) == 0 && 
-                                        S_ISREG(st.st_mode) && 
-                                        (st.st_mode & (S_IXUSR | S_IXGRP | S_IXOTH))) {
-                                        
-                                        // Check for duplicates
-                                        int duplicate = 0;
-                                        for (int i = 0; i < count; i++) {
-                                            if (strcmp(entry->d_name, completions[i]) == 0) {
-                                                duplicate = 1;
-                                                break;
-                                            }
-                                        }
-                                        
-                                        if (!duplicate) {
-                                            // Add to completions
-                                            if (count >= capacity) {
-                                                capacity *= 2;
-                                                char **new_completions = realloc(completions, capacity * sizeof(char*));
-                                                if (!new_completions) {
-                                                    for (int j = 0; j < count; j++) free(completions[j]);
-                                                    free(completions);
-                                                    *completions_ptr = NULL;
-                                                    *num_completions_ptr = 0;
-                                                    closedir(dir);
-                                                    free(path_copy);
-                                                    return;
-                                                }
-                                                completions = new_completions;
-                                            }
-                                            
-                                            completions[count] = strdup(entry->d_name);
-                                            if (completions[count]) count++;
-                                        }
-                                    }
-                                }
-                            }
-                            closedir(dir);
-                        }
-                        path = strtok(NULL, ":");
-                    }
-                    free(path_copy);
-                }
-            }
-        } else {
-            // Argument completion - complete from current directory
-            get_directory_completions(".", prefix, &completions, &count);
-        }
+        // Argument completion - complete from current directory
+        get_directory_completions(".", prefix, &completions, &count);
     }
     
     // Sort completions alphabetically
@@ -424,22 +592,23 @@ void display_completions(char **completions, int num_completions, const char *in
     
     int num_rows = (num_completions + num_cols - 1) / num_cols;
     
-    // Print a newline and all completions
-    printf("\n");
+    // Print a newline and all completions; the whole listing drains
+    // as one write at the end
+    out_putc('\n');
     
     for (int row = 0; row < num_rows; row++) {
         for (int col = 0; col < num_cols; col++) {
             int index = col * num_rows + row;
             if (index < num_completions) {
-                printf("%-*s", max_width, completions[index]);
+                out_printf("%-*s", max_width, completions[index]);
             }
         }
-        printf("\n");
+        out_putc('\n');
     }
     
     // Print prompt and input again
-    printf("$ %s", input);
-    fflush(stdout);
+    out_printf("$ %s", input);
+    out_flush();
 }
 
 /**
@@ -476,79 +645,72 @@ int get_directory_completions(const char *dir_path, const char *prefix,
         return -1;
     }
     
-    DIR *dir = opendir(dir_path);
-    if (!dir) {
+    // Read through the shared listing cache: the directory flag was
+    // resolved at scan time, so there is no per-entry stat here
+    int entry_count = 0;
+    const DirCacheEntry *entries = dir_cache_get(dir_path, &entry_count);
+    if (!entries) {
         ERROR_SYSTEM(ERR_IO, "Failed to open directory: %s", dir_path);
         return -1;
     }
-    
+
     char **completions = *completions_ptr;
     int count = *num_completions_ptr;
     int capacity = count > 0 ? count * 2 : 10;
-    
+
     // Make sure we have enough space
     if (count == 0) {
         completions = malloc(capacity * sizeof(char*));
         if (!completions) {
             ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
-            closedir(dir);
             return -1;
         }
     }
-    
-    struct dirent *entry;
-    while ((entry = readdir(dir)) != NULL) {
+
+    for (int i = 0; i < entry_count; i++) {
+        const char *name = entries[i].name;
+
         // Skip . and .. unless specifically requested
         if (strcmp(prefix, ".") != 0 && strcmp(prefix, "..") != 0) {
-            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
                 continue;
             }
         }
-        
+
         // Check if entry matches prefix
-        if (prefix_match(entry->d_name, prefix)) {
-            // Create full path for stat
-            char full_path[PATH_MAX];
-            snprintf(full_path, PATH_MAX, "%s/%s", dir_path, entry->d_name);
-            
-            // Check if it's a directory
-            struct stat st;
-            if (stat(full_path, &st) == 0) {
-                // Allocate space for completion (with trailing slash for directories)
-                char *completion;
-                if (S_ISDIR(st.st_mode)) {
-                    // Directory - add trailing slash
-                    completion = malloc(strlen(entry->d_name) + 2);
-                    if (completion) {
-                        strcpy(completion, entry->d_name);
-                        strcat(completion, "/");
-                    }
-                } else {
-                    // Regular file
-                    completion = strdup(entry->d_name);
-                }
-                
+        if (prefix_match(name, prefix)) {
+            // Allocate space for completion (with trailing slash for directories)
+            char *completion;
+            if (entries[i].is_dir) {
+                // Directory - add trailing slash
+                completion = malloc(strlen(name) + 2);
                 if (completion) {
-                    // Check if we need to resize
-                    if (count >= capacity) {
-                        capacity *= 2;
-                        char **new_completions = realloc(completions, capacity * sizeof(char*));
-                        if (!new_completions) {
-                            free(completion);
-                            continue;
-                        }
-                        completions = new_completions;
+                    strcpy(completion, name);
+                    strcat(completion, "/");
+                }
+            } else {
+                // Regular file
+                completion = strdup(name);
+            }
+
+            if (completion) {
+                // Check if we need to resize
+                if (count >= capacity) {
+                    capacity *= 2;
+                    char **new_completions = realloc(completions, capacity * sizeof(char*));
+                    if (!new_completions) {
+                        free(completion);
+                        continue;
                     }
-                    
-                    // Add to completions
-                    completions[count++] = completion;
+                    completions = new_completions;
                 }
+
+                // Add to completions
+                completions[count++] = completion;
             }
         }
     }
-    
-    closedir(dir);
-    
+
     // Update output parameters
     *completions_ptr = completions;
     *num_completions_ptr = count;
@@ -0,0 +1,481 @@
+/**
+ * @file index.c
+ * @brief Executable name index implementation
+ *
+ * Implementation of the prebuilt completion index. The index is a
+ * sorted, deduplicated array of every built-in and PATH executable
+ * name, built lazily on first use and refreshed when $PATH or a PATH
+ * directory's mtime changes. The build scans PATH directories in
+ * parallel, one worker thread each, and k-way-merges the sorted
+ * results. Lookups are a binary search for the start of the matching
+ * range - no filesystem access on the Tab path.
+ */
+
+#include "completion/index.h"
+#include "completion/matcher.h"
+#include "builtins/builtins.h"
+#include "utils/error.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
+
+// How often (in seconds) lookups re-check PATH directory mtimes
+#define INDEX_CHECK_INTERVAL 1
+
+// Sorted, deduplicated executable names
+static char **index_names = NULL;
+static int index_count = 0;
+static int index_capacity = 0;
+
+// The $PATH the index was built from, and the mtimes of its
+// directories at build time
+static char *indexed_path_env = NULL;
+static char **indexed_dirs = NULL;
+static time_t *indexed_dir_mtimes = NULL;
+static int num_indexed_dirs = 0;
+
+// Throttle for mtime revalidation
+static time_t last_index_check = 0;
+
+/**
+ * @brief Free the index name array
+ */
+static void index_free_names(void) {
+    if (index_names) {
+        for (int i = 0; i < index_count; i++) {
+            free(index_names[i]);
+        }
+        free(index_names);
+        index_names = NULL;
+    }
+    index_count = 0;
+    index_capacity = 0;
+}
+
+/**
+ * @brief Free the indexed directory metadata
+ */
+static void index_free_dirs(void) {
+    if (indexed_dirs) {
+        for (int i = 0; i < num_indexed_dirs; i++) {
+            free(indexed_dirs[i]);
+        }
+        free(indexed_dirs);
+        indexed_dirs = NULL;
+    }
+    free(indexed_dir_mtimes);
+    indexed_dir_mtimes = NULL;
+    num_indexed_dirs = 0;
+
+    free(indexed_path_env);
+    indexed_path_env = NULL;
+}
+
+/**
+ * @brief One scan worker's private name list
+ *
+ * Each PATH directory is scanned by its own worker into one of
+ * these, so the build takes no locks; the lists are merged on the
+ * calling thread once every worker has joined.
+ */
+typedef struct {
+    const char *dir_path;   /**< Directory to scan (NULL for the built-in list) */
+    char **names;           /**< Collected names, sorted before the merge */
+    int count;              /**< Number of names collected */
+    int capacity;           /**< Allocated slots */
+} ScanList;
+
+/**
+ * @brief Append a name to a scan list
+ *
+ * Duplicates across lists are not checked here - they are dropped by
+ * the merge.
+ *
+ * @param list List to append to
+ * @param name Name to append
+ * @return int 0 on success, non-zero on error
+ */
+static int scan_list_append(ScanList *list, const char *name) {
+    if (list->count >= list->capacity) {
+        int new_capacity = list->capacity > 0 ? list->capacity * 2 : 256;
+        char **new_names = realloc(list->names, new_capacity * sizeof(char*));
+        if (!new_names) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        list->names = new_names;
+        list->capacity = new_capacity;
+    }
+
+    list->names[list->count] = strdup(name);
+    if (!list->names[list->count]) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    list->count++;
+    return 0;
+}
+
+/**
+ * @brief Compare two names for qsort
+ */
+static int scan_name_cmp(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/**
+ * @brief Scan one PATH directory into its list
+ *
+ * Worker body: collects every executable regular file in the
+ * directory, then sorts the list so the merge can treat every input
+ * as ordered. Touches only its own ScanList, so workers need no
+ * synchronization beyond the join.
+ *
+ * @param arg ScanList for this worker's directory
+ * @return void* Always NULL
+ */
+static void *index_scan_worker(void *arg) {
+    ScanList *list = arg;
+
+    DIR *dir = opendir(list->dir_path);
+    if (!dir) {
+        return NULL;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        char full_path[PATH_MAX];
+        snprintf(full_path, PATH_MAX, "%s/%s", list->dir_path, entry->d_name);
+
+        struct stat st;
+        if (stat(full_path, &st) == 0 &&
+            S_ISREG(st.st_mode) &&
+            (st.st_mode & (S_IXUSR | S_IXGRP | S_IXOTH))) {
+            if (scan_list_append(list, entry->d_name) != 0) {
+                break;
+            }
+        }
+    }
+
+    closedir(dir);
+    qsort(list->names, list->count, sizeof(char*), scan_name_cmp);
+    return NULL;
+}
+
+/**
+ * @brief Merge sorted scan lists into the index array
+ *
+ * K-way merge with deduplication: each step takes the smallest name
+ * among the list heads, emitting it only if it differs from the last
+ * name emitted. The lists' name pointers move into the index;
+ * duplicates are freed here.
+ *
+ * @param lists Sorted lists to merge
+ * @param num_lists Number of lists
+ * @return int 0 on success, non-zero on error
+ */
+static int index_merge_lists(ScanList *lists, int num_lists) {
+    int total = 0;
+    for (int i = 0; i < num_lists; i++) {
+        total += lists[i].count;
+    }
+
+    index_names = malloc((total > 0 ? total : 1) * sizeof(char*));
+    if (!index_names) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+    index_capacity = total > 0 ? total : 1;
+    index_count = 0;
+
+    int *pos = calloc(num_lists, sizeof(int));
+    if (!pos) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    // PATH has a handful of directories, so a linear scan over the
+    // list heads beats maintaining a heap
+    while (1) {
+        int best = -1;
+        for (int i = 0; i < num_lists; i++) {
+            if (pos[i] >= lists[i].count) {
+                continue;
+            }
+            if (best == -1 ||
+                strcmp(lists[i].names[pos[i]], lists[best].names[pos[best]]) < 0) {
+                best = i;
+            }
+        }
+        if (best == -1) {
+            break;
+        }
+
+        char *name = lists[best].names[pos[best]++];
+        if (index_count > 0 &&
+            strcmp(index_names[index_count - 1], name) == 0) {
+            free(name);
+        } else {
+            index_names[index_count++] = name;
+        }
+    }
+
+    free(pos);
+    return 0;
+}
+
+/**
+ * @brief Build the index from built-ins and PATH
+ *
+ * Fans out one worker thread per PATH directory, so build wall time
+ * is the slowest directory's readdir rather than the sum - a cold
+ * NFS mount in $PATH delays the build by its own latency only. The
+ * sorted per-directory lists (plus the built-in names) are combined
+ * with a k-way merge on the calling thread.
+ *
+ * @return int 0 on success, non-zero on error
+ */
+static int index_build(void) {
+    index_free_names();
+    index_free_dirs();
+
+    ScanList *lists = NULL;
+    pthread_t *threads = NULL;
+    int num_lists = 1;  // List 0 holds the built-in names
+
+    char *path_env = getenv("PATH");
+    char *path_copy = NULL;
+    if (path_env) {
+        indexed_path_env = strdup(path_env);
+        if (!indexed_path_env) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+
+        // Count the directories first so the metadata arrays can be
+        // allocated in one shot
+        int num_dirs = 1;
+        for (char *p = path_env; *p != '\0'; p++) {
+            if (*p == ':') num_dirs++;
+        }
+
+        indexed_dirs = calloc(num_dirs, sizeof(char*));
+        indexed_dir_mtimes = calloc(num_dirs, sizeof(time_t));
+        path_copy = strdup(path_env);
+        if (!indexed_dirs || !indexed_dir_mtimes || !path_copy) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            free(path_copy);
+            return -1;
+        }
+
+        char *dir_path = strtok(path_copy, ":");
+        while (dir_path != NULL) {
+            indexed_dirs[num_indexed_dirs] = strdup(dir_path);
+
+            struct stat st;
+            indexed_dir_mtimes[num_indexed_dirs] =
+                (stat(dir_path, &st) == 0) ? st.st_mtime : 0;
+            num_indexed_dirs++;
+
+            dir_path = strtok(NULL, ":");
+        }
+        num_lists += num_indexed_dirs;
+    }
+
+    lists = calloc(num_lists, sizeof(ScanList));
+    threads = calloc(num_lists, sizeof(pthread_t));
+    if (!lists || !threads) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        free(lists);
+        free(threads);
+        free(path_copy);
+        return -1;
+    }
+
+    // Built-in commands complete alongside PATH executables; their
+    // table is not sorted, so this list goes through qsort too
+    const BuiltinCommand *builtins = get_builtin_commands();
+    for (int i = 0; builtins[i].name != NULL; i++) {
+        scan_list_append(&lists[0], builtins[i].name);
+    }
+    qsort(lists[0].names, lists[0].count, sizeof(char*), scan_name_cmp);
+
+    // Fan out one scan worker per directory; a failed create just
+    // runs that directory's scan on this thread
+    int *threaded = calloc(num_lists, sizeof(int));
+    for (int i = 1; i < num_lists; i++) {
+        lists[i].dir_path = indexed_dirs[i - 1];
+        if (threaded &&
+            pthread_create(&threads[i], NULL, index_scan_worker, &lists[i]) == 0) {
+            threaded[i] = 1;
+        } else {
+            index_scan_worker(&lists[i]);
+        }
+    }
+
+    for (int i = 1; i < num_lists; i++) {
+        if (threaded && threaded[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    free(threaded);
+
+    int result = index_merge_lists(lists, num_lists);
+
+    // The merge moved or freed every name; only the containers remain
+    for (int i = 0; i < num_lists; i++) {
+        free(lists[i].names);
+    }
+    free(lists);
+    free(threads);
+    free(path_copy);
+
+    last_index_check = time(NULL);
+    return result;
+}
+
+/**
+ * @brief Check whether the index is still current
+ *
+ * Compares $PATH against the value the index was built from, then
+ * (at most once per INDEX_CHECK_INTERVAL seconds) re-stats the PATH
+ * directories and compares mtimes.
+ *
+ * @return int 1 if current, 0 if a rebuild is needed
+ */
+static int index_is_current(void) {
+    if (!index_names) {
+        return 0;
+    }
+
+    char *path_env = getenv("PATH");
+    if ((path_env == NULL) != (indexed_path_env == NULL) ||
+        (path_env && strcmp(path_env, indexed_path_env) != 0)) {
+        return 0;
+    }
+
+    time_t now = time(NULL);
+    if (now - last_index_check < INDEX_CHECK_INTERVAL) {
+        return 1;
+    }
+    last_index_check = now;
+
+    for (int i = 0; i < num_indexed_dirs; i++) {
+        struct stat st;
+        time_t mtime = (stat(indexed_dirs[i], &st) == 0) ? st.st_mtime : 0;
+        if (mtime != indexed_dir_mtimes[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Find the first index entry >= prefix
+ *
+ * Standard lower-bound binary search over the sorted name array.
+ *
+ * @param prefix Prefix to search for
+ * @return int Index of the first candidate entry
+ */
+static int index_lower_bound(const char *prefix) {
+    int lo = 0;
+    int hi = index_count;
+
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (strcmp(index_names[mid], prefix) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Look up command completions in the index
+ *
+ * Ensures the index is current, then binary-searches for the range
+ * of names matching the prefix.
+ *
+ * @param prefix Prefix to complete
+ * @param num_matches Pointer to store number of matches
+ * @return char** Array of matching names (caller must free with
+ *         free_completions), NULL if there are no matches
+ */
+char **completion_index_lookup(const char *prefix, int *num_matches) {
+    if (!prefix || !num_matches) {
+        return NULL;
+    }
+    *num_matches = 0;
+
+    if (!index_is_current() && index_build() != 0) {
+        return NULL;
+    }
+
+    // All matches are contiguous in the sorted array
+    int start = index_lower_bound(prefix);
+    int end = start;
+    while (end < index_count && prefix_match(index_names[end], prefix)) {
+        end++;
+    }
+
+    int count = end - start;
+    if (count == 0) {
+        return NULL;
+    }
+
+    char **matches = malloc(count * sizeof(char*));
+    if (!matches) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        matches[i] = strdup(index_names[start + i]);
+        if (!matches[i]) {
+            for (int j = 0; j < i; j++) {
+                free(matches[j]);
+            }
+            free(matches);
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return NULL;
+        }
+    }
+
+    *num_matches = count;
+    return matches;
+}
+
+/**
+ * @brief Force a rebuild of the executable index
+ *
+ * Drops the current index; it is rebuilt on the next lookup.
+ */
+void completion_index_invalidate(void) {
+    index_free_names();
+    index_free_dirs();
+}
+
+/**
+ * @brief Destroy the executable index
+ *
+ * Frees all index storage.
+ */
+void completion_index_destroy(void) {
+    index_free_names();
+    index_free_dirs();
+}
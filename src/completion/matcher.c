@@ -231,4 +231,110 @@ int sort_and_deduplicate(char **completions, int *num_completions) {
     
     *num_completions = new_count;
     return new_count;
-}
\ No newline at end of file
+}
+/**
+ * @brief Initialize an incremental matcher
+ * 
+ * Starts with an empty query, so every candidate matches.
+ * 
+ * @param im Matcher state to initialize
+ * @param candidates Array of candidate strings
+ * @param num_candidates Number of candidates
+ * @return int 0 on success, non-zero on error
+ */
+int incremental_matcher_init(IncrementalMatcher *im,
+                             const char **candidates, int num_candidates) {
+    if (!im || (!candidates && num_candidates > 0) || num_candidates < 0) {
+        return -1;
+    }
+    
+    im->candidates = candidates;
+    im->num_candidates = num_candidates;
+    im->num_matches = num_candidates;
+    im->query[0] = '\0';
+    im->query_len = 0;
+    
+    im->matches = malloc(num_candidates > 0 ? num_candidates * sizeof(int) : sizeof(int));
+    if (!im->matches) {
+        return -1;
+    }
+    
+    // Empty query - every candidate survives
+    for (int i = 0; i < num_candidates; i++) {
+        im->matches[i] = i;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Append a character to the query
+ * 
+ * Narrows the surviving set in place instead of rescanning all
+ * candidates.
+ * 
+ * @param im Matcher state
+ * @param c Character to append
+ * @return int Number of surviving matches
+ */
+int incremental_matcher_push(IncrementalMatcher *im, char c) {
+    if (!im || !im->matches || im->query_len >= MATCHER_QUERY_MAX - 1) {
+        return im ? im->num_matches : 0;
+    }
+    
+    im->query[im->query_len++] = c;
+    im->query[im->query_len] = '\0';
+    
+    // Filter the previous result set: anything containing the longer
+    // query also contained the shorter one
+    int kept = 0;
+    for (int i = 0; i < im->num_matches; i++) {
+        if (strstr(im->candidates[im->matches[i]], im->query) != NULL) {
+            im->matches[kept++] = im->matches[i];
+        }
+    }
+    
+    im->num_matches = kept;
+    return kept;
+}
+
+/**
+ * @brief Remove the last character from the query
+ * 
+ * Widening cannot reuse the narrowed set, so the full candidate
+ * array is rescanned with the shorter query.
+ * 
+ * @param im Matcher state
+ * @return int Number of surviving matches
+ */
+int incremental_matcher_pop(IncrementalMatcher *im) {
+    if (!im || !im->matches || im->query_len == 0) {
+        return im ? im->num_matches : 0;
+    }
+    
+    im->query[--im->query_len] = '\0';
+    
+    int kept = 0;
+    for (int i = 0; i < im->num_candidates; i++) {
+        if (im->query_len == 0 ||
+            strstr(im->candidates[i], im->query) != NULL) {
+            im->matches[kept++] = i;
+        }
+    }
+    
+    im->num_matches = kept;
+    return kept;
+}
+
+/**
+ * @brief Clean up an incremental matcher
+ * 
+ * @param im Matcher state to clean up
+ */
+void incremental_matcher_free(IncrementalMatcher *im) {
+    if (im && im->matches) {
+        free(im->matches);
+        im->matches = NULL;
+        im->num_matches = 0;
+    }
+}
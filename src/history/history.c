@@ -0,0 +1,254 @@
+/**
+ * @file history.c
+ * @brief Command history implementation
+ *
+ * Implementation of persistent command history. The history file is
+ * an append-only log of newline-terminated entries. At startup it is
+ * mmap'd MAP_PRIVATE and the newlines in the private copy-on-write
+ * mapping are overwritten with NULs, so every past entry becomes a
+ * usable C string in place - a 100k-entry history loads without a
+ * single per-line allocation. New entries are written through an
+ * O_APPEND descriptor; the file is never rewritten.
+ */
+
+#include "history/history.h"
+#include "utils/error.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Name of the history file, created in $HOME
+#define HISTORY_FILE_NAME ".cshell_history"
+
+// In-memory ring of entry pointers; oldest first
+static const char **entries = NULL;
+static int entry_count = 0;
+static int entry_capacity = 0;
+
+// How many of the oldest entries point into the mapping (and must
+// therefore not be free()d individually)
+static int num_mapped_entries = 0;
+
+// The mapped history file and the append descriptor
+static char *history_map = NULL;
+static size_t history_map_size = 0;
+static int history_fd = -1;
+
+// Whether history_init() has run; the file is loaded lazily on the
+// first history operation, so batch invocations never touch it
+static int history_loaded = 0;
+
+/**
+ * @brief Append an entry pointer to the ring
+ *
+ * Evicts the oldest entry when the ring is full.
+ *
+ * @param text Entry text (mapped or heap-allocated)
+ * @return int 0 on success, non-zero on error
+ */
+static int history_append_entry(const char *text) {
+    if (entry_count >= HISTORY_MAX_ENTRIES) {
+        // Evict the oldest entry; mapped entries live in the mapping
+        // until munmap, heap entries are freed here
+        if (num_mapped_entries > 0) {
+            num_mapped_entries--;
+        } else {
+            free((char *)entries[0]);
+        }
+        memmove(entries, entries + 1, (entry_count - 1) * sizeof(char*));
+        entry_count--;
+    }
+
+    if (entry_count >= entry_capacity) {
+        int new_capacity = entry_capacity > 0 ? entry_capacity * 2 : 256;
+        const char **new_entries = realloc(entries, new_capacity * sizeof(char*));
+        if (!new_entries) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        entries = new_entries;
+        entry_capacity = new_capacity;
+    }
+
+    entries[entry_count++] = text;
+    return 0;
+}
+
+/**
+ * @brief Build the history file path
+ *
+ * @param path Buffer to fill (PATH_MAX bytes)
+ * @return int 0 on success, non-zero if $HOME is unset
+ */
+static int history_file_path(char *path) {
+    char *home = getenv("HOME");
+    if (!home) {
+        return -1;
+    }
+
+    snprintf(path, PATH_MAX, "%s/%s", home, HISTORY_FILE_NAME);
+    return 0;
+}
+
+/**
+ * @brief Initialize the history subsystem
+ *
+ * Opens the history file and maps past entries into memory. Called
+ * lazily from the first history operation; calling it again before
+ * history_cleanup() is a no-op.
+ *
+ * @return int 0 on success, non-zero on error
+ */
+int history_init(void) {
+    if (history_loaded) {
+        return 0;
+    }
+    history_loaded = 1;
+
+    char path[PATH_MAX];
+    if (history_file_path(path) != 0) {
+        // No $HOME - run with session-only history
+        return 0;
+    }
+
+    history_fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0600);
+    if (history_fd == -1) {
+        ERROR_SYSTEM(ERR_IO, "Failed to open history file: %s", path);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(history_fd, &st) != 0 || st.st_size == 0) {
+        return 0;  // Nothing to load
+    }
+
+    history_map_size = st.st_size;
+    history_map = mmap(NULL, history_map_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE, history_fd, 0);
+    if (history_map == MAP_FAILED) {
+        ERROR_SYSTEM(ERR_IO, "Failed to map history file");
+        history_map = NULL;
+        history_map_size = 0;
+        return -1;
+    }
+
+    // Turn each line of the private mapping into a C string in place
+    char *line_start = history_map;
+    char *end = history_map + history_map_size;
+
+    for (char *p = history_map; p < end; p++) {
+        if (*p == '\n') {
+            *p = '\0';
+            if (p > line_start) {
+                history_append_entry(line_start);
+            }
+            line_start = p + 1;
+        }
+    }
+
+    num_mapped_entries = entry_count;
+    return 0;
+}
+
+/**
+ * @brief Clean up the history subsystem
+ */
+void history_cleanup(void) {
+    // Heap entries follow the mapped ones in the ring
+    for (int i = num_mapped_entries; i < entry_count; i++) {
+        free((char *)entries[i]);
+    }
+    free(entries);
+    entries = NULL;
+    entry_count = 0;
+    entry_capacity = 0;
+    num_mapped_entries = 0;
+
+    if (history_map) {
+        munmap(history_map, history_map_size);
+        history_map = NULL;
+        history_map_size = 0;
+    }
+
+    if (history_fd != -1) {
+        close(history_fd);
+        history_fd = -1;
+    }
+
+    history_loaded = 0;
+}
+
+/**
+ * @brief Add a line to history
+ *
+ * Appends the line to the in-memory ring and the history file.
+ * Empty lines and immediate duplicates are skipped.
+ *
+ * @param line Command line to record
+ * @return int 0 on success, non-zero on error
+ */
+int history_add(const char *line) {
+    if (!line || *line == '\0') {
+        return 0;
+    }
+
+    history_init();
+
+    // Skip if identical to the most recent entry
+    if (entry_count > 0 && strcmp(entries[entry_count - 1], line) == 0) {
+        return 0;
+    }
+
+    char *copy = strdup(line);
+    if (!copy) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    if (history_append_entry(copy) != 0) {
+        free(copy);
+        return -1;
+    }
+
+    // Append to the log; O_APPEND keeps concurrent shells safe
+    if (history_fd != -1) {
+        size_t len = strlen(line);
+        if (write(history_fd, line, len) == -1 ||
+            write(history_fd, "\n", 1) == -1) {
+            ERROR_SYSTEM(ERR_IO, "Failed to append to history file");
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Get the number of history entries
+ *
+ * @return int Number of entries currently held in memory
+ */
+int history_count(void) {
+    history_init();
+    return entry_count;
+}
+
+/**
+ * @brief Get a history entry
+ *
+ * @param index Entry index: 0 is the oldest, history_count()-1 the newest
+ * @return const char* Entry text, NULL if out of range
+ */
+const char *history_get(int index) {
+    history_init();
+
+    if (index < 0 || index >= entry_count) {
+        return NULL;
+    }
+
+    return entries[index];
+}
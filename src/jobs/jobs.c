@@ -0,0 +1,270 @@
+/**
+ * @file jobs.c
+ * @brief Background job control implementation
+ *
+ * The job table is updated from two sides: the shell loop adds and
+ * reports jobs, and the SIGCHLD handler marks them done as children
+ * exit. The handler touches only pid/state/status fields, and every
+ * foreground wait runs with SIGCHLD blocked, so the two sides never
+ * race over the same child.
+ */
+
+#include "jobs/jobs.h"
+#include "utils/error.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Job table
+static Job job_table[MAX_JOBS];
+static int next_job_id = 1;
+
+/**
+ * @brief SIGCHLD handler
+ *
+ * Reaps every exited child without blocking and marks the matching
+ * job done. Foreground children are kept out of reach by blocking
+ * SIGCHLD from before they are forked until the executor's own
+ * waitpid() has collected them; only background jobs land here.
+ *
+ * @param sig Signal number (unused)
+ */
+static void sigchld_handler(int sig) {
+    (void)sig;
+    int saved_errno = errno;
+    int status;
+    pid_t pid;
+
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        for (int i = 0; i < MAX_JOBS; i++) {
+            if (job_table[i].state == JOB_RUNNING && job_table[i].pid == pid) {
+                job_table[i].status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+                job_table[i].state = JOB_DONE;
+                break;
+            }
+        }
+    }
+
+    errno = saved_errno;
+}
+
+/**
+ * @brief Initialize job control
+ *
+ * @return int 0 on success, non-zero on error
+ */
+int jobs_init(void) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sigchld_handler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+
+    if (sigaction(SIGCHLD, &sa, NULL) != 0) {
+        ERROR_SYSTEM(ERR_SYSTEM, "Failed to install SIGCHLD handler");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Add a job to the table
+ *
+ * @param pid Process ID of the job
+ * @param cmdline Command line as typed (copied)
+ * @return int Job number, or -1 if the table is full
+ */
+int job_add(pid_t pid, const char *cmdline) {
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (job_table[i].state == JOB_FREE) {
+            job_table[i].id = next_job_id++;
+            job_table[i].pid = pid;
+            job_table[i].status = 0;
+            job_table[i].cmdline = cmdline ? strdup(cmdline) : NULL;
+            // Publish the slot last so the handler never sees a
+            // half-filled entry
+            job_table[i].state = JOB_RUNNING;
+            return job_table[i].id;
+        }
+    }
+
+    ERROR_ERROR(ERR_SYSTEM, "Job table is full");
+    return -1;
+}
+
+/**
+ * @brief Block SIGCHLD delivery
+ */
+void jobs_block_sigchld(void) {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &set, NULL);
+}
+
+/**
+ * @brief Unblock SIGCHLD delivery
+ */
+void jobs_unblock_sigchld(void) {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGCHLD);
+    sigprocmask(SIG_UNBLOCK, &set, NULL);
+}
+
+/**
+ * @brief Reset the signal mask in a forked child
+ *
+ * The executor forks with SIGCHLD blocked; a child must not carry
+ * that block across exec. Gives the child an empty mask.
+ */
+void jobs_reset_child_sigmask(void) {
+    sigset_t set;
+    sigemptyset(&set);
+    sigprocmask(SIG_SETMASK, &set, NULL);
+}
+
+/**
+ * @brief Release a job's table slot
+ *
+ * @param job Job entry to clear
+ */
+static void job_release(Job *job) {
+    free(job->cmdline);
+    job->cmdline = NULL;
+    job->pid = 0;
+    job->state = JOB_FREE;
+}
+
+/**
+ * @brief Report finished background jobs
+ */
+void jobs_report_finished(void) {
+    jobs_block_sigchld();
+
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (job_table[i].state == JOB_DONE) {
+            printf("[%d] Done (%d)    %s\n", job_table[i].id,
+                   job_table[i].status,
+                   job_table[i].cmdline ? job_table[i].cmdline : "");
+            job_release(&job_table[i]);
+        }
+    }
+
+    jobs_unblock_sigchld();
+}
+
+/**
+ * @brief Print the job table
+ */
+void jobs_print(void) {
+    jobs_block_sigchld();
+
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (job_table[i].state != JOB_FREE) {
+            printf("[%d] %-8s %d    %s\n", job_table[i].id,
+                   job_table[i].state == JOB_RUNNING ? "Running" : "Done",
+                   (int)job_table[i].pid,
+                   job_table[i].cmdline ? job_table[i].cmdline : "");
+        }
+    }
+
+    jobs_unblock_sigchld();
+}
+
+/**
+ * @brief Find a job entry by job number
+ *
+ * Must be called with SIGCHLD blocked.
+ *
+ * @param id Job number, or 0 for the most recent job
+ * @return Job* Matching entry, or NULL
+ */
+static Job *job_find(int id) {
+    Job *found = NULL;
+
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (job_table[i].state == JOB_FREE) continue;
+        if (id == 0) {
+            // Most recent job: highest id
+            if (!found || job_table[i].id > found->id) {
+                found = &job_table[i];
+            }
+        } else if (job_table[i].id == id) {
+            return &job_table[i];
+        }
+    }
+
+    return (id == 0) ? found : NULL;
+}
+
+/**
+ * @brief Wait for one job to finish
+ *
+ * @param id Job number, or 0 for the most recent job
+ * @return int Exit status of the job, -1 if no such job
+ */
+int job_wait(int id) {
+    sigset_t block_set, suspend_mask;
+    sigemptyset(&block_set);
+    sigaddset(&block_set, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &block_set, &suspend_mask);
+    sigdelset(&suspend_mask, SIGCHLD);
+
+    Job *job = job_find(id);
+    if (!job) {
+        sigprocmask(SIG_UNBLOCK, &block_set, NULL);
+        return -1;
+    }
+
+    // Sleep until the handler marks this job done; sigsuspend
+    // atomically unblocks SIGCHLD and waits, so there is no window
+    // where the signal can be lost
+    while (job->state == JOB_RUNNING) {
+        sigsuspend(&suspend_mask);
+    }
+
+    int status = job->status;
+    job_release(job);
+
+    sigprocmask(SIG_UNBLOCK, &block_set, NULL);
+    return status;
+}
+
+/**
+ * @brief Wait for all background jobs to finish
+ *
+ * @return int 0 on success
+ */
+int jobs_wait_all(void) {
+    while (1) {
+        jobs_block_sigchld();
+        Job *job = job_find(0);
+        int id = job ? job->id : -1;
+        jobs_unblock_sigchld();
+
+        if (id == -1) break;
+        job_wait(id);
+    }
+    return 0;
+}
+
+/**
+ * @brief Release the job table
+ */
+void jobs_cleanup(void) {
+    jobs_block_sigchld();
+
+    for (int i = 0; i < MAX_JOBS; i++) {
+        if (job_table[i].state != JOB_FREE) {
+            job_release(&job_table[i]);
+        }
+    }
+
+    jobs_unblock_sigchld();
+}
@@ -6,15 +6,28 @@
  */
 
 #include "shell.h"
+#include "command/alias.h"
+#include "command/redirection.h"
+#include "completion/index.h"
+#include "history/history.h"
+#include "jobs/jobs.h"
 #include "terminal/terminal.h"
+#include "utils/dircache.h"
+#include "utils/dirjump.h"
 #include "utils/error.h"
+#include "utils/memory.h"
+#include "utils/output.h"
+#include "utils/string.h"
+#include "utils/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <signal.h>
-
-/** Global verbose flag */
-int g_verbose_mode = 0;
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /**
  * @brief Signal handler for SIGINT
@@ -34,12 +47,16 @@ static void sigint_handler(int sig) {
  * @brief Print usage information
  */
 static void print_usage(const char *program_name) {
-    printf("Usage: %s [OPTIONS]\n\n", program_name);
+    printf("Usage: %s [OPTIONS] [script]\n\n", program_name);
     printf("Options:\n");
+    printf("  -c COMMAND     Run COMMAND and exit (batch mode)\n");
     printf("  -h, --help     Display this help message\n");
     printf("  -v, --verbose  Enable verbose output\n");
     printf("  -V, --version  Display version information\n");
+    printf("  --profile-startup  Print per-phase startup timings to stderr\n");
     printf("\n");
+    printf("With a script argument, commands are read from the file\n");
+    printf("instead of the terminal.\n");
 }
 
 /**
@@ -50,9 +67,42 @@ static void print_version(void) {
     printf("A robust shell implementation in C\n");
 }
 
+// Batch-mode inputs picked up by parse_args
+static const char *batch_command = NULL;  // -c COMMAND
+static const char *script_path = NULL;    // Positional script argument
+
+// --profile-startup: report per-phase init timings on stderr
+static int profile_startup = 0;
+
+// Stamped at the top of main() so the profile can report time from
+// process entry, not just from shell_init()
+static long startup_origin_ns = 0;
+
+/**
+ * @brief Read the monotonic clock in nanoseconds
+ *
+ * @return long Current time in ns
+ */
+static long startup_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/**
+ * @brief Print one startup profile row
+ *
+ * @param phase Phase name
+ * @param ns Phase duration in nanoseconds
+ */
+static void profile_phase(const char *phase, long ns) {
+    fprintf(stderr, "  %-18s %7ld.%01ld us\n", phase,
+            ns / 1000, (ns % 1000) / 100);
+}
+
 /**
  * @brief Parse command line arguments
- * 
+ *
  * @param argc Argument count
  * @param argv Argument vector
  * @return int 0 on success, non-zero on error
@@ -68,33 +118,69 @@ static int parse_args(int argc, char *argv[]) {
         } else if (strcmp(argv[i], "-V") == 0 || strcmp(argv[i], "--version") == 0) {
             print_version();
             exit(EXIT_SUCCESS);
+        } else if (strcmp(argv[i], "--profile-startup") == 0) {
+            profile_startup = 1;
+        } else if (strcmp(argv[i], "-c") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "%s: -c: option requires an argument\n", argv[0]);
+                return 1;
+            }
+            batch_command = argv[++i];
+        } else if (argv[i][0] != '-' && script_path == NULL) {
+            script_path = argv[i];
         } else {
             fprintf(stderr, "Unknown option: %s\n", argv[i]);
             print_usage(argv[0]);
             return 1;
         }
     }
-    
+
     return 0;
 }
 
 /**
  * @brief Initialize the shell
- * 
+ *
+ * Only the terminal and job control are set up eagerly; the history
+ * file, directory jump index, and completion index all load lazily
+ * on their first use, so an interactive shell reaches its first
+ * prompt without touching any of them.
+ *
  * @return int 0 on success, non-zero on error
  */
 int shell_init(void) {
+    long t0 = profile_startup ? startup_now_ns() : 0;
+
     // Set up signal handlers
     signal(SIGINT, sigint_handler);
-    
+
     // Initialize terminal
     if (terminal_init() != 0) {
         ERROR_ERROR(ERR_SYSTEM, "Failed to initialize terminal");
         return 1;
     }
-    
+
+    long t1 = profile_startup ? startup_now_ns() : 0;
+
+    // Install the SIGCHLD handler for background job reaping
+    if (jobs_init() != 0) {
+        ERROR_ERROR(ERR_SYSTEM, "Failed to initialize job control");
+        return 1;
+    }
+
+    if (profile_startup) {
+        long t2 = startup_now_ns();
+        fprintf(stderr, "startup profile:\n");
+        profile_phase("entry to init", t0 - startup_origin_ns);
+        profile_phase("terminal setup", t1 - t0);
+        profile_phase("job control", t2 - t1);
+        profile_phase("total to prompt", t2 - startup_origin_ns);
+        fprintf(stderr, "  history, jump index, completion index: "
+                        "deferred until first use\n");
+    }
+
     ERROR_DEBUG("Shell initialized");
-    
+
     return 0;
 }
 
@@ -104,7 +190,38 @@ int shell_init(void) {
 void shell_cleanup(void) {
     // Restore terminal settings
     terminal_cleanup();
-    
+
+    // Dump latency histograms when tracing was on
+    if (trace_enabled()) {
+        trace_dump(stderr);
+    }
+
+    // Likewise the per-command resource totals
+    if (rusage_enabled()) {
+        trace_rusage_dump(stderr);
+    }
+
+    // And any error records still parked in the deferred channel
+    if (error_log_pending()) {
+        error_log_drain(stderr);
+    }
+
+    // Drain and release the builtin output buffer
+    out_destroy();
+
+    // Release the command arena, caches, history, aliases, and jobs
+    arena_destroy();
+    dir_cache_destroy();
+    redir_fd_cache_destroy();
+    completion_index_destroy();
+    history_cleanup();
+    dirjump_cleanup();
+    alias_cleanup();
+    jobs_cleanup();
+
+    // Last: the caches and alias table above hold interned pointers
+    str_intern_destroy();
+
     ERROR_DEBUG("Shell cleaned up");
 }
 
@@ -117,61 +234,261 @@ void shell_cleanup(void) {
  * @return int Exit status
  */
 int shell_loop(void) {
-    char input[INPUT_BUFFER_SIZE];
     int status = 0;
-    
+
     while (1) {
+        // Report background jobs that finished since the last prompt
+        jobs_report_finished();
+
+        // The shell is idle here: flush any deferred error records
+        if (error_log_pending()) {
+            error_log_drain(stderr);
+        }
+
         // Display prompt
         display_prompt();
-        
-        // Read input
-        if (read_line(input, INPUT_BUFFER_SIZE) < 0) {
-            if (feof(stdin)) {
-                // End of file (Ctrl+D)
-                printf("\n");
-                break;
-            }
-            ERROR_ERROR(ERR_IO, "Failed to read input");
-            continue;
+
+        // Read input; the line arrives in a heap buffer sized by the
+        // editor, so pasted input longer than any fixed limit survives
+        char *input = read_line();
+        if (input == NULL) {
+            // End of file (Ctrl+D) or read error - either way, stop looping
+            printf("\n");
+            return 0;
         }
-        
+
+        // Record the line before executing it
+        history_add(input);
+
         // Process command
         status = process_command(input);
-        
+        free(input);
+
         // Check for exit
         if (status < 0) {
             break;
         }
     }
-    
+
+    return status;
+}
+
+/**
+ * @brief Run a single command string in batch mode
+ *
+ * The -c path: no terminal setup, no prompt, no history - just parse
+ * and execute. This keeps startup-to-first-command latency minimal
+ * for callers that spawn the shell per command.
+ *
+ * @param command Command string to run
+ * @return int Exit status of the command
+ */
+static int run_batch_command(const char *command) {
+    // Job control still applies: '&' is valid in batch commands
+    jobs_init();
+
+    if (profile_startup) {
+        fprintf(stderr, "startup profile (batch):\n");
+        profile_phase("entry to command", startup_now_ns() - startup_origin_ns);
+    }
+
+    // No fixed-size copy here: generated command lines can run well
+    // past INPUT_BUFFER_SIZE
+    char *line = strdup(command);
+    if (!line) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return EXIT_FAILURE;
+    }
+
+    int status = process_command(line);
+    free(line);
+
+    jobs_wait_all();
+    out_destroy();
+    arena_destroy();
+    dir_cache_destroy();
+    redir_fd_cache_destroy();
+    alias_cleanup();
+    jobs_cleanup();
+    str_intern_destroy();
+
+    // Flush any error records parked in the deferred channel
+    if (error_log_pending()) {
+        error_log_drain(stderr);
+    }
+
+    return status < 0 ? 1 : status;
+}
+
+/**
+ * @brief Run the lines of an in-memory script image
+ *
+ * Splits the image at newlines with memchr() and feeds each line to
+ * process_command(). Lines are copied into the command arena first -
+ * the parsers rewrite their input in place and the image is mapped
+ * read-only - and the copy is reclaimed by the arena reset at the
+ * end of each command, so the steady state allocates nothing.
+ *
+ * @param base Start of the script text (not NUL-terminated)
+ * @param size Size of the script text in bytes
+ * @return int Exit status of the last command
+ */
+static int run_script_image(const char *base, size_t size) {
+    const char *p = base;
+    const char *end = base + size;
+    int status = 0;
+
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        const char *next = nl ? nl + 1 : end;
+        size_t len = (size_t)((nl ? nl : end) - p);
+
+        // Skip blank lines and comments without copying them
+        const char *start = p;
+        while (len > 0 && (*start == ' ' || *start == '\t')) {
+            start++;
+            len--;
+        }
+        if (len == 0 || *start == '#') {
+            p = next;
+            continue;
+        }
+
+        char *line = arena_alloc(len + 1);
+        if (!line) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        memcpy(line, start, len);
+        line[len] = '\0';
+
+        status = process_command(line);
+        p = next;
+    }
+
     return status;
 }
 
+/**
+ * @brief Run a script file in batch mode
+ *
+ * mmaps the whole file and splits lines out of the mapping, so a
+ * large script costs no read() copies and no per-line buffer growth;
+ * sources mmap cannot handle (pipes, /dev/stdin) fall back to a
+ * getline() loop. No raw mode, no line editor either way. Blank
+ * lines and '#' comments are skipped.
+ *
+ * @param path Path to the script file
+ * @return int Exit status of the last command
+ */
+static int run_batch_script(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        fprintf(stderr, "%s: cannot open file\n", path);
+        return EXIT_FAILURE;
+    }
+
+    struct stat st;
+    char *image = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        image = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    jobs_init();
+
+    if (profile_startup) {
+        fprintf(stderr, "startup profile (script):\n");
+        profile_phase("entry to script", startup_now_ns() - startup_origin_ns);
+    }
+
+    int status = 0;
+    if (image != MAP_FAILED) {
+        close(fd);
+        status = run_script_image(image, (size_t)st.st_size);
+        munmap(image, (size_t)st.st_size);
+    } else {
+        // Not a regular file: stream it line by line instead
+        FILE *fp = fdopen(fd, "r");
+        if (!fp) {
+            close(fd);
+            fprintf(stderr, "%s: cannot open file\n", path);
+            return EXIT_FAILURE;
+        }
+
+        char *line = NULL;
+        size_t line_capacity = 0;
+        ssize_t len;
+
+        while ((len = getline(&line, &line_capacity, fp)) != -1) {
+            if (len > 0 && line[len - 1] == '\n') {
+                line[len - 1] = '\0';
+            }
+
+            char *start = line;
+            while (*start == ' ' || *start == '\t') start++;
+            if (*start == '\0' || *start == '#') {
+                continue;
+            }
+
+            status = process_command(start);
+        }
+
+        free(line);
+        fclose(fp);
+    }
+
+    jobs_wait_all();
+    out_destroy();
+    arena_destroy();
+    dir_cache_destroy();
+    redir_fd_cache_destroy();
+    alias_cleanup();
+    jobs_cleanup();
+    str_intern_destroy();
+
+    // Flush any error records parked in the deferred channel
+    if (error_log_pending()) {
+        error_log_drain(stderr);
+    }
+
+    return status < 0 ? 1 : status;
+}
+
 /**
  * @brief Main function
- * 
+ *
  * @param argc Argument count
  * @param argv Argument vector
  * @return int Exit status
  */
 int main(int argc, char *argv[]) {
     int status;
-    
+
+    startup_origin_ns = startup_now_ns();
+
     // Parse command line arguments
     if (parse_args(argc, argv) != 0) {
         return EXIT_FAILURE;
     }
-    
+
+    // Batch modes skip terminal setup entirely
+    if (batch_command != NULL) {
+        return run_batch_command(batch_command);
+    }
+    if (script_path != NULL) {
+        return run_batch_script(script_path);
+    }
+
     // Initialize shell
     if (shell_init() != 0) {
         return EXIT_FAILURE;
     }
-    
+
     // Run shell loop
     status = shell_loop();
-    
+
     // Clean up
     shell_cleanup();
-    
+
     return status;
 }
\ No newline at end of file
@@ -0,0 +1,202 @@
+/**
+ * @file dircache.c
+ * @brief Cached directory listings implementation
+ *
+ * Keeps a handful of recently used directory listings in memory. Each
+ * slot stores the directory path, its mtime at scan time, and a
+ * name-sorted entry array with a per-entry directory flag (resolved
+ * once at scan time, so callers never stat individual entries). A
+ * lookup stats only the directory itself; when the mtime is unchanged
+ * the cached listing is returned as-is.
+ */
+
+#include "utils/dircache.h"
+#include "utils/error.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+// Number of directories kept resident; the oldest slot is evicted
+#define DIR_CACHE_SLOTS 8
+
+/**
+ * @brief One cached directory
+ */
+typedef struct {
+    char *path;               /**< Directory path (NULL = free slot) */
+    time_t mtime;             /**< Directory mtime at scan time */
+    DirCacheEntry *entries;   /**< Sorted entries */
+    int count;                /**< Number of entries */
+    unsigned long last_used;  /**< LRU stamp */
+} DirCacheSlot;
+
+static DirCacheSlot cache[DIR_CACHE_SLOTS];
+static unsigned long use_counter = 0;
+
+/**
+ * @brief Release one slot's listing
+ *
+ * @param slot Slot to clear
+ */
+static void slot_release(DirCacheSlot *slot) {
+    for (int i = 0; i < slot->count; i++) {
+        free(slot->entries[i].name);
+    }
+    free(slot->entries);
+    free(slot->path);
+    slot->path = NULL;
+    slot->entries = NULL;
+    slot->count = 0;
+}
+
+/**
+ * @brief Compare two entries by name for qsort
+ *
+ * @param a First entry
+ * @param b Second entry
+ * @return int Comparison result
+ */
+static int compare_entries(const void *a, const void *b) {
+    return strcmp(((const DirCacheEntry *)a)->name,
+                  ((const DirCacheEntry *)b)->name);
+}
+
+/**
+ * @brief Scan a directory into a slot
+ *
+ * Reads all entries, resolves the directory flag for each, and sorts
+ * them by name.
+ *
+ * @param slot Slot to fill (must be released)
+ * @param path Directory path
+ * @param mtime Directory mtime observed before the scan
+ * @return int 0 on success, non-zero on error
+ */
+static int slot_scan(DirCacheSlot *slot, const char *path, time_t mtime) {
+    DIR *dir = opendir(path);
+    if (!dir) {
+        return -1;
+    }
+
+    int capacity = 16;
+    DirCacheEntry *entries = malloc(capacity * sizeof(DirCacheEntry));
+    if (!entries) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        closedir(dir);
+        return -1;
+    }
+
+    int count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (count >= capacity) {
+            capacity *= 2;
+            DirCacheEntry *new_entries =
+                realloc(entries, capacity * sizeof(DirCacheEntry));
+            if (!new_entries) {
+                ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                break;
+            }
+            entries = new_entries;
+        }
+
+        char *name = strdup(entry->d_name);
+        if (!name) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            break;
+        }
+
+        // Resolve the directory flag once, at scan time
+        char full_path[PATH_MAX];
+        snprintf(full_path, PATH_MAX, "%s/%s", path, entry->d_name);
+        struct stat st;
+        int is_dir = (stat(full_path, &st) == 0 && S_ISDIR(st.st_mode));
+
+        entries[count].name = name;
+        entries[count].is_dir = is_dir;
+        count++;
+    }
+    closedir(dir);
+
+    qsort(entries, count, sizeof(DirCacheEntry), compare_entries);
+
+    slot->path = strdup(path);
+    if (!slot->path) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        for (int i = 0; i < count; i++) free(entries[i].name);
+        free(entries);
+        return -1;
+    }
+    slot->mtime = mtime;
+    slot->entries = entries;
+    slot->count = count;
+    return 0;
+}
+
+/**
+ * @brief Get the sorted listing of a directory
+ *
+ * Returns the cached listing when the directory's mtime is unchanged,
+ * otherwise rescans it. The returned array is owned by the cache and
+ * valid until the next dir_cache_get() call or dir_cache_destroy().
+ *
+ * @param path Directory path
+ * @param count Out: number of entries
+ * @return const DirCacheEntry* Sorted entries, NULL if unreadable
+ */
+const DirCacheEntry *dir_cache_get(const char *path, int *count) {
+    if (!path || !count) {
+        return NULL;
+    }
+
+    // One stat of the directory decides hit vs rescan
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return NULL;
+    }
+
+    DirCacheSlot *victim = &cache[0];
+    for (int i = 0; i < DIR_CACHE_SLOTS; i++) {
+        DirCacheSlot *slot = &cache[i];
+        if (slot->path && strcmp(slot->path, path) == 0) {
+            if (slot->mtime == st.st_mtime) {
+                slot->last_used = ++use_counter;
+                *count = slot->count;
+                return slot->entries;
+            }
+            // Stale: rescan into the same slot
+            victim = slot;
+            break;
+        }
+        if (!slot->path) {
+            victim = slot;
+        } else if (victim->path && slot->last_used < victim->last_used) {
+            victim = slot;
+        }
+    }
+
+    if (victim->path) {
+        slot_release(victim);
+    }
+    if (slot_scan(victim, path, st.st_mtime) != 0) {
+        return NULL;
+    }
+
+    victim->last_used = ++use_counter;
+    *count = victim->count;
+    return victim->entries;
+}
+
+/**
+ * @brief Release all cached listings
+ */
+void dir_cache_destroy(void) {
+    for (int i = 0; i < DIR_CACHE_SLOTS; i++) {
+        if (cache[i].path) {
+            slot_release(&cache[i]);
+        }
+    }
+}
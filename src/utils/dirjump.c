@@ -0,0 +1,332 @@
+/**
+ * @file dirjump.c
+ * @brief Frecency-ranked directory jump index implementation
+ *
+ * The index is a flat array of (path, visit count, last visit)
+ * records. Scoring follows the usual frecency shape: the visit count
+ * weighted up for directories used within the hour and down for ones
+ * not touched in a week. Persistence is one compact binary file in
+ * $HOME, rewritten at cleanup only when the index changed - at the
+ * 512-entry cap that is a few tens of kilobytes.
+ */
+
+#include "utils/dirjump.h"
+#include "utils/error.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+// Name of the index file, created in $HOME
+#define DIRJUMP_FILE_NAME ".cshell_dirs"
+
+// File magic ("CSDJ") and format version
+#define DIRJUMP_MAGIC   0x4A445343u
+#define DIRJUMP_VERSION 1u
+
+/**
+ * @brief One tracked directory
+ */
+typedef struct {
+    char *path;          /**< Absolute path (owned) */
+    uint32_t rank;       /**< Visit count */
+    int64_t last_visit;  /**< Epoch seconds of the last visit */
+} DirJumpEntry;
+
+static DirJumpEntry *entries = NULL;
+static int num_entries = 0;
+static int capacity = 0;
+static int dirty = 0;
+
+// Whether dirjump_init() has run; the index file is loaded lazily on
+// the first record or resolve, so batch invocations never touch it
+static int loaded = 0;
+
+/**
+ * @brief Build the index file path
+ *
+ * @param path Buffer to fill (PATH_MAX bytes)
+ * @return int 0 on success, non-zero if $HOME is unset
+ */
+static int dirjump_file_path(char *path) {
+    char *home = getenv("HOME");
+    if (!home) {
+        return -1;
+    }
+
+    snprintf(path, PATH_MAX, "%s/%s", home, DIRJUMP_FILE_NAME);
+    return 0;
+}
+
+/**
+ * @brief Score an entry
+ *
+ * Visit count weighted by recency, the standard frecency shape.
+ *
+ * @param entry Entry to score
+ * @param now Current time in epoch seconds
+ * @return double Frecency score
+ */
+static double dirjump_score(const DirJumpEntry *entry, long now) {
+    long age = now - (long)entry->last_visit;
+    double rank = (double)entry->rank;
+
+    if (age < 3600) return rank * 4.0;
+    if (age < 86400) return rank * 2.0;
+    if (age < 604800) return rank / 2.0;
+    return rank / 4.0;
+}
+
+/**
+ * @brief Remove an entry by index
+ *
+ * @param i Index of the entry to drop
+ */
+static void dirjump_remove(int i) {
+    free(entries[i].path);
+    entries[i] = entries[num_entries - 1];
+    num_entries--;
+    dirty = 1;
+}
+
+/**
+ * @brief Initialize the jump index
+ *
+ * Called lazily from the first record or resolve; calling it again
+ * before dirjump_cleanup() is a no-op.
+ *
+ * @return int 0 on success, non-zero on error
+ */
+int dirjump_init(void) {
+    if (loaded) {
+        return 0;
+    }
+    loaded = 1;
+
+    char path[PATH_MAX];
+    if (dirjump_file_path(path) != 0) {
+        // No $HOME - run with a session-only index
+        return 0;
+    }
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        return 0;  // Nothing to load
+    }
+
+    uint32_t header[3];  // magic, version, count
+    if (fread(header, sizeof(header), 1, fp) != 1 ||
+        header[0] != DIRJUMP_MAGIC || header[1] != DIRJUMP_VERSION) {
+        fclose(fp);
+        return 0;  // Unknown format: start fresh
+    }
+
+    uint32_t count = header[2];
+    if (count > DIRJUMP_MAX_ENTRIES) {
+        count = DIRJUMP_MAX_ENTRIES;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t rank, len;
+        int64_t last;
+        if (fread(&rank, sizeof(rank), 1, fp) != 1 ||
+            fread(&last, sizeof(last), 1, fp) != 1 ||
+            fread(&len, sizeof(len), 1, fp) != 1 ||
+            len == 0 || len >= PATH_MAX) {
+            break;  // Truncated or corrupt: keep what loaded cleanly
+        }
+
+        char *entry_path = malloc(len + 1);
+        if (!entry_path) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            break;
+        }
+        if (fread(entry_path, len, 1, fp) != 1) {
+            free(entry_path);
+            break;
+        }
+        entry_path[len] = '\0';
+
+        if (num_entries >= capacity) {
+            int new_capacity = capacity > 0 ? capacity * 2 : 64;
+            DirJumpEntry *grown = realloc(entries, new_capacity * sizeof(DirJumpEntry));
+            if (!grown) {
+                ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+                free(entry_path);
+                break;
+            }
+            entries = grown;
+            capacity = new_capacity;
+        }
+
+        entries[num_entries].path = entry_path;
+        entries[num_entries].rank = rank;
+        entries[num_entries].last_visit = last;
+        num_entries++;
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+/**
+ * @brief Clean up the jump index
+ */
+void dirjump_cleanup(void) {
+    char path[PATH_MAX];
+    if (dirty && dirjump_file_path(path) == 0) {
+        // Rewrite the whole file; it is small and this runs once
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        FILE *fp = fd != -1 ? fdopen(fd, "wb") : NULL;
+        if (fp) {
+            uint32_t header[3] = { DIRJUMP_MAGIC, DIRJUMP_VERSION,
+                                   (uint32_t)num_entries };
+            fwrite(header, sizeof(header), 1, fp);
+
+            for (int i = 0; i < num_entries; i++) {
+                uint32_t len = (uint32_t)strlen(entries[i].path);
+                fwrite(&entries[i].rank, sizeof(uint32_t), 1, fp);
+                fwrite(&entries[i].last_visit, sizeof(int64_t), 1, fp);
+                fwrite(&len, sizeof(uint32_t), 1, fp);
+                fwrite(entries[i].path, len, 1, fp);
+            }
+            fclose(fp);
+        } else if (fd != -1) {
+            close(fd);
+        }
+    }
+
+    for (int i = 0; i < num_entries; i++) {
+        free(entries[i].path);
+    }
+    free(entries);
+    entries = NULL;
+    num_entries = 0;
+    capacity = 0;
+    dirty = 0;
+    loaded = 0;
+}
+
+/**
+ * @brief Record a visit to a directory
+ *
+ * @param path Absolute path of the visited directory
+ */
+void dirjump_record(const char *path) {
+    if (!path || path[0] != '/') {
+        return;
+    }
+
+    dirjump_init();
+
+    long now = time(NULL);
+
+    for (int i = 0; i < num_entries; i++) {
+        if (strcmp(entries[i].path, path) == 0) {
+            entries[i].rank++;
+            entries[i].last_visit = now;
+            dirty = 1;
+            return;
+        }
+    }
+
+    char *copy = strdup(path);
+    if (!copy) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return;
+    }
+
+    if (num_entries >= DIRJUMP_MAX_ENTRIES) {
+        // Evict the lowest-scored entry to make room
+        int victim = 0;
+        double victim_score = dirjump_score(&entries[0], now);
+        for (int i = 1; i < num_entries; i++) {
+            double score = dirjump_score(&entries[i], now);
+            if (score < victim_score) {
+                victim = i;
+                victim_score = score;
+            }
+        }
+        free(entries[victim].path);
+        entries[victim].path = copy;
+        entries[victim].rank = 1;
+        entries[victim].last_visit = now;
+        dirty = 1;
+        return;
+    }
+
+    if (num_entries >= capacity) {
+        int new_capacity = capacity > 0 ? capacity * 2 : 64;
+        DirJumpEntry *grown = realloc(entries, new_capacity * sizeof(DirJumpEntry));
+        if (!grown) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            free(copy);
+            return;
+        }
+        entries = grown;
+        capacity = new_capacity;
+    }
+
+    entries[num_entries].path = copy;
+    entries[num_entries].rank = 1;
+    entries[num_entries].last_visit = now;
+    num_entries++;
+    dirty = 1;
+}
+
+/**
+ * @brief Resolve a name against the jump index
+ *
+ * @param query Name to resolve
+ * @return const char* Best matching path, NULL if nothing matches
+ */
+const char *dirjump_resolve(const char *query) {
+    if (!query || *query == '\0') {
+        return NULL;
+    }
+
+    dirjump_init();
+
+    long now = time(NULL);
+    const char *best = NULL;
+    double best_score = 0.0;
+
+    for (int i = 0; i < num_entries; i++) {
+        const char *base = strrchr(entries[i].path, '/');
+        base = base ? base + 1 : entries[i].path;
+
+        // Matches in the final component count full; a hit anywhere
+        // else in the path counts half
+        double weight;
+        if (strstr(base, query) != NULL) {
+            weight = 1.0;
+        } else if (strstr(entries[i].path, query) != NULL) {
+            weight = 0.5;
+        } else {
+            continue;
+        }
+
+        double score = dirjump_score(&entries[i], now) * weight;
+        if (best != NULL && score <= best_score) {
+            continue;
+        }
+
+        // Prune directories that no longer exist as they are met
+        struct stat st;
+        if (stat(entries[i].path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+            dirjump_remove(i);
+            i--;
+            continue;
+        }
+
+        best = entries[i].path;
+        best_score = score;
+    }
+
+    return best;
+}
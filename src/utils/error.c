@@ -6,6 +6,7 @@
  */
 
 #include "utils/error.h"
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -51,11 +52,124 @@ static const char *error_code_messages[] = {
     "Feature not implemented"    // ERR_NOT_IMPLEMENTED
 };
 
+// Ring size for the deferred log channel; must be a power of two so
+// the sequence number wraps cleanly into a slot index
+#define ERROR_RING_SLOTS 256
+
+/**
+ * @brief One deferred log record
+ *
+ * The message snapshot is taken at deposit time (varargs cannot be
+ * parked for later), but it is a bounded in-memory format - the
+ * expensive parts, strerror() and the unbuffered stderr write,
+ * happen at drain time.
+ */
+typedef struct {
+    ErrorLevel level;   /**< Severity */
+    ErrorCode code;     /**< Error code */
+    int err;            /**< Saved errno, -1 if not a system error */
+    int line;           /**< Source line */
+    const char *file;   /**< Source file (static string) */
+    const char *func;   /**< Function name (static string) */
+    char message[96];   /**< Formatted message snapshot */
+} ErrorRecord;
+
+static ErrorRecord ring[ERROR_RING_SLOTS];
+
+// Total records deposited and drained. The head is atomic so a
+// deposit from a signal handler or forked child claims its slot with
+// one fetch-add; the tail is only touched by the draining side.
+static _Atomic unsigned int ring_head = 0;
+static unsigned int ring_tail = 0;
+
+/**
+ * @brief Check whether the deferred log channel is enabled
+ *
+ * @return int 1 if deferred logging is enabled, 0 otherwise
+ */
+int error_log_async(void) {
+    static int enabled = -1;
+
+    if (enabled == -1) {
+        char *value = getenv("CSHELL_ASYNC_LOG");
+        enabled = (value != NULL && strcmp(value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+/**
+ * @brief Deposit a record into the ring
+ *
+ * One atomic fetch-add claims the slot; an overflowing ring
+ * overwrites its oldest records, which the drain reports.
+ *
+ * @param level Severity
+ * @param code Error code
+ * @param err Saved errno, -1 if not a system error
+ * @param file Source file
+ * @param line Source line
+ * @param func Function name
+ * @param message Formatted message snapshot
+ */
+static void error_log_deposit(ErrorLevel level, ErrorCode code, int err,
+                              const char *file, int line, const char *func,
+                              const char *message) {
+    unsigned int seq = atomic_fetch_add_explicit(&ring_head, 1,
+                                                 memory_order_relaxed);
+    ErrorRecord *record = &ring[seq % ERROR_RING_SLOTS];
+
+    record->level = level;
+    record->code = code;
+    record->err = err;
+    record->file = file;
+    record->line = line;
+    record->func = func;
+    snprintf(record->message, sizeof(record->message), "%s", message);
+}
+
+/**
+ * @brief Check for undrained log records
+ *
+ * @return int 1 if records are waiting, 0 otherwise
+ */
+int error_log_pending(void) {
+    return atomic_load_explicit(&ring_head, memory_order_relaxed) != ring_tail;
+}
+
+/**
+ * @brief Format and emit all pending log records
+ *
+ * @param fp Output stream
+ */
+void error_log_drain(FILE *fp) {
+    unsigned int head = atomic_load_explicit(&ring_head, memory_order_acquire);
+
+    if (head - ring_tail > ERROR_RING_SLOTS) {
+        fprintf(fp, "[log] %u records overwritten before drain\n",
+                head - ring_tail - ERROR_RING_SLOTS);
+        ring_tail = head - ERROR_RING_SLOTS;
+    }
+
+    while (ring_tail != head) {
+        const ErrorRecord *record = &ring[ring_tail % ERROR_RING_SLOTS];
+        const char *level_str = error_level_strings[record->level];
+
+        if (record->err >= 0) {
+            fprintf(fp, "[%s] %s: %s\n", level_str, record->message,
+                    strerror(record->err));
+        } else {
+            fprintf(fp, "[%s] %s\n", level_str, record->message);
+        }
+        ring_tail++;
+    }
+}
+
 /**
  * @brief Set error level
- * 
+ *
  * Sets the minimum error level to display.
- * 
+ *
  * @param level Minimum error level
  */
 void error_set_level(ErrorLevel level) {
@@ -108,7 +222,14 @@ void error_report(ErrorLevel level, ErrorCode code, const char *file,
         error_handler(level, code, file, line, func, message);
         return;
     }
-    
+
+    // Deferred channel: park the record and return without touching
+    // stderr; fatal errors always print inline
+    if (error_log_async() && level != ERROR_FATAL) {
+        error_log_deposit(level, code, -1, file, line, func, message);
+        return;
+    }
+
     // Standard error handling
     const char *level_str = error_level_strings[level];
     
@@ -154,12 +275,21 @@ void error_system(ErrorLevel level, ErrorCode code, const char *file,
     vsnprintf(message, sizeof(message), format, args);
     va_end(args);
     
-    // Append system error message
     int saved_errno = errno;
+
+    // Deferred channel: park the saved errno instead of resolving it
+    // here - strerror() runs at drain time, off the hot path (and out
+    // of any forked child this is called from)
+    if (error_log_async() && level != ERROR_FATAL && !error_handler) {
+        error_log_deposit(level, code, saved_errno, file, line, func, message);
+        return;
+    }
+
+    // Append system error message
     char full_message[2048];
-    snprintf(full_message, sizeof(full_message), "%s: %s", 
+    snprintf(full_message, sizeof(full_message), "%s: %s",
              message, strerror(saved_errno));
-    
+
     // Report the error
     error_report(level, code, file, line, func, full_message);
 }
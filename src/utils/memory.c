@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 // Memory statistics (for debug builds)
 #ifdef DEBUG
@@ -207,9 +208,180 @@ void *debug_malloc(size_t size, const char *file, int line) {
     return ptr;
 }
 
+// Default size for command arena blocks; large enough that a typical
+// command line never needs a second block
+#define ARENA_BLOCK_SIZE 4096
+
+/**
+ * @brief Arena block
+ *
+ * One contiguous chunk of arena storage. Blocks are chained when a
+ * command needs more than ARENA_BLOCK_SIZE bytes.
+ */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;  /**< Next (older) block in the chain */
+    size_t capacity;          /**< Usable bytes in data[] */
+    size_t used;              /**< Bytes handed out so far */
+    char data[];              /**< Block storage */
+} ArenaBlock;
+
+// Head of the block chain; the newest block is allocated from first
+static ArenaBlock *arena_head = NULL;
+
+// Pool statistics, kept in release builds: counting an increment per
+// allocation is noise next to the allocation itself, and the hit rate
+// is what tells us the resident block is actually recycling
+static size_t arena_alloc_count = 0;     // Allocations served
+static size_t arena_block_mallocs = 0;   // Block allocations (pool misses)
+static size_t arena_reset_count = 0;     // Commands processed
+static size_t arena_bytes_served = 0;    // Total bytes handed out
+static size_t arena_peak_command = 0;    // Largest single-command footprint
+static size_t arena_current_command = 0; // Bytes served since last reset
+
+/**
+ * @brief Allocate a new arena block
+ *
+ * @param min_size Minimum usable size the block must provide
+ * @return ArenaBlock* New block, NULL on failure
+ */
+static ArenaBlock *arena_new_block(size_t min_size) {
+    size_t capacity = min_size > ARENA_BLOCK_SIZE ? min_size : ARENA_BLOCK_SIZE;
+
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + capacity);
+    if (!block) {
+        ERROR_ERROR(ERR_MEMORY, "Failed to allocate arena block of %zu bytes", capacity);
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    return block;
+}
+
+/**
+ * @brief Allocate from the command arena
+ *
+ * Bump-allocates from the per-command arena. Arena memory is never
+ * freed individually - the whole arena is recycled by arena_reset()
+ * at the end of each processed command.
+ *
+ * @param size Size to allocate
+ * @return void* Allocated memory, NULL on failure
+ */
+void *arena_alloc(size_t size) {
+    if (size == 0) {
+        return NULL;
+    }
+
+    // Keep allocations 8-byte aligned so structs can live in the arena
+    size = (size + 7) & ~(size_t)7;
+
+    if (!arena_head || arena_head->used + size > arena_head->capacity) {
+        ArenaBlock *block = arena_new_block(size);
+        if (!block) {
+            return NULL;
+        }
+        block->next = arena_head;
+        arena_head = block;
+        arena_block_mallocs++;
+    }
+
+    arena_alloc_count++;
+    arena_bytes_served += size;
+    arena_current_command += size;
+
+    void *ptr = arena_head->data + arena_head->used;
+    arena_head->used += size;
+    return ptr;
+}
+
+/**
+ * @brief Duplicate a string into the command arena
+ *
+ * @param str String to duplicate
+ * @return char* Arena-allocated copy, NULL on failure
+ */
+char *arena_strdup(const char *str) {
+    if (!str) {
+        return NULL;
+    }
+
+    size_t len = strlen(str);
+    char *copy = arena_alloc(len + 1);
+    if (copy) {
+        memcpy(copy, str, len + 1);
+    }
+    return copy;
+}
+
+/**
+ * @brief Reset the command arena
+ *
+ * Reclaims all arena allocations in O(1): the oldest block is kept
+ * for reuse and any overflow blocks are returned to the system.
+ */
+void arena_reset(void) {
+    // Free every block except the last (oldest) one, which is kept
+    // warm so steady-state command processing never touches malloc
+    while (arena_head && arena_head->next) {
+        ArenaBlock *block = arena_head;
+        arena_head = block->next;
+        free(block);
+    }
+
+    if (arena_head) {
+        arena_head->used = 0;
+    }
+
+    arena_reset_count++;
+    if (arena_current_command > arena_peak_command) {
+        arena_peak_command = arena_current_command;
+    }
+    arena_current_command = 0;
+}
+
+/**
+ * @brief Dump arena pool statistics
+ *
+ * Reports how well command state is being recycled: every allocation
+ * served without a block malloc is a pool hit, so steady state should
+ * show a hit rate near 100% (one miss for the initial resident block,
+ * plus one per oversized command).
+ *
+ * @param fp Output stream
+ */
+void arena_stats_dump(FILE *fp) {
+    double hit_rate = 100.0;
+    if (arena_alloc_count > 0) {
+        hit_rate = 100.0 * (arena_alloc_count - arena_block_mallocs)
+                   / arena_alloc_count;
+    }
+
+    fprintf(fp, "arena pool: %zu allocations over %zu commands, "
+            "%zu block mallocs (%.2f%% hit rate)\n",
+            arena_alloc_count, arena_reset_count,
+            arena_block_mallocs, hit_rate);
+    fprintf(fp, "            %zu bytes served, peak %zu bytes per command\n",
+            arena_bytes_served, arena_peak_command);
+}
+
+/**
+ * @brief Destroy the command arena
+ *
+ * Frees all arena blocks, including the resident one.
+ */
+void arena_destroy(void) {
+    while (arena_head) {
+        ArenaBlock *block = arena_head;
+        arena_head = block->next;
+        free(block);
+    }
+}
+
 /**
  * @brief Print memory statistics
- * 
+ *
  * Prints memory allocation statistics (debug build only).
  */
 void print_memory_stats(void) {
@@ -0,0 +1,169 @@
+/**
+ * @file output.c
+ * @brief Buffered builtin output writer implementation
+ *
+ * Implementation of the shell-owned output buffer. One contiguous
+ * allocation grows by doubling and is drained with a single write(2)
+ * per flush, so a loop of builtins redirected to a file - or 10k
+ * completion entries - costs a handful of large writes rather than
+ * thousands of small ones.
+ */
+
+#include "utils/output.h"
+#include "utils/error.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Initial buffer allocation; typical builtin output fits without
+// ever growing
+#define OUT_INITIAL_CAPACITY 4096
+
+static char *out_buf = NULL;
+static size_t out_len = 0;
+static size_t out_capacity = 0;
+
+/**
+ * @brief Ensure room for more bytes
+ *
+ * @param extra Number of bytes about to be appended
+ * @return int 0 on success, non-zero on error
+ */
+static int out_reserve(size_t extra) {
+    if (out_len + extra <= out_capacity) {
+        return 0;
+    }
+
+    size_t new_capacity = out_capacity > 0 ? out_capacity : OUT_INITIAL_CAPACITY;
+    while (out_len + extra > new_capacity) {
+        new_capacity *= 2;
+    }
+
+    char *new_buf = realloc(out_buf, new_capacity);
+    if (!new_buf) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    out_buf = new_buf;
+    out_capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * @brief Append bytes to the output buffer
+ *
+ * @param data Bytes to append
+ * @param len Number of bytes
+ * @return int 0 on success, non-zero on error
+ */
+int out_write(const char *data, size_t len) {
+    if (!data) {
+        return -1;
+    }
+    if (out_reserve(len) != 0) {
+        return -1;
+    }
+
+    memcpy(out_buf + out_len, data, len);
+    out_len += len;
+    return 0;
+}
+
+/**
+ * @brief Append one character to the output buffer
+ *
+ * @param c Character to append
+ * @return int 0 on success, non-zero on error
+ */
+int out_putc(char c) {
+    if (out_reserve(1) != 0) {
+        return -1;
+    }
+
+    out_buf[out_len++] = c;
+    return 0;
+}
+
+/**
+ * @brief Append formatted text to the output buffer
+ *
+ * Formats into the buffer's spare space; when the first attempt is
+ * truncated, grows once to the reported size and reformats.
+ *
+ * @param format Format string
+ * @param ... Format arguments
+ * @return int 0 on success, non-zero on error
+ */
+int out_printf(const char *format, ...) {
+    if (!format) {
+        return -1;
+    }
+    if (out_reserve(64) != 0) {
+        return -1;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int needed = vsnprintf(out_buf + out_len, out_capacity - out_len,
+                           format, args);
+    va_end(args);
+
+    if (needed < 0) {
+        return -1;
+    }
+
+    if ((size_t)needed >= out_capacity - out_len) {
+        // Truncated: make room for the full text and format again
+        if (out_reserve((size_t)needed + 1) != 0) {
+            return -1;
+        }
+        va_start(args, format);
+        vsnprintf(out_buf + out_len, out_capacity - out_len, format, args);
+        va_end(args);
+    }
+
+    out_len += (size_t)needed;
+    return 0;
+}
+
+/**
+ * @brief Write the buffered output to stdout
+ *
+ * @return int 0 on success, non-zero if the write failed
+ */
+int out_flush(void) {
+    if (out_len == 0) {
+        return 0;
+    }
+
+    // Anything the shell printed through stdio goes first, so the
+    // two paths never reorder around a flush point
+    fflush(stdout);
+
+    size_t done = 0;
+    while (done < out_len) {
+        ssize_t n = write(STDOUT_FILENO, out_buf + done, out_len - done);
+        if (n < 0) {
+            out_len = 0;
+            return -1;
+        }
+        done += (size_t)n;
+    }
+
+    out_len = 0;
+    return 0;
+}
+
+/**
+ * @brief Flush and release the output buffer
+ */
+void out_destroy(void) {
+    out_flush();
+    free(out_buf);
+    out_buf = NULL;
+    out_len = 0;
+    out_capacity = 0;
+}
@@ -7,6 +7,7 @@
 
 #include "utils/path.h"
 #include "utils/error.h"
+#include "utils/string.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,6 +16,40 @@
 #include <limits.h>
 #include <libgen.h>
 #include <errno.h>
+#include <time.h>
+
+/** Number of hash buckets in the executable cache */
+#define PATH_CACHE_BUCKETS 64
+
+/** Minimum seconds between directory mtime revalidations */
+#define PATH_CACHE_CHECK_INTERVAL 1
+
+/**
+ * @brief Executable cache entry
+ *
+ * Maps an executable name to its resolved full path. Entries with a
+ * NULL full_path are negative entries (command known not to exist).
+ */
+typedef struct PathCacheEntry {
+    const char *name;             /**< Executable name (interned hash key) */
+    const char *full_path;        /**< Interned resolved path, NULL for negative entries */
+    int dir_index;                /**< Index of resolving directory in cached_dirs */
+    struct PathCacheEntry *next;  /**< Next entry in hash chain */
+} PathCacheEntry;
+
+/** Hash table of cached lookups */
+static PathCacheEntry *path_cache[PATH_CACHE_BUCKETS];
+
+/** Copy of the $PATH value the cache was built against */
+static char *cached_path_env = NULL;
+
+/** PATH directories and the mtime observed for each */
+static char **cached_dirs = NULL;
+static time_t *cached_dir_mtimes = NULL;
+static int num_cached_dirs = 0;
+
+/** Time of the last mtime revalidation pass */
+static time_t last_validation_time = 0;
 
 /**
  * @brief Get directory name
@@ -462,4 +497,288 @@ char *path_search(const char *filename) {
     
     free(path_copy);
     return result;
-}
\ No newline at end of file
+}
+/**
+ * @brief Hash an executable name
+ *
+ * @param name Name to hash
+ * @return unsigned int Bucket index
+ */
+static unsigned int path_cache_hash(const char *name) {
+    // djb2 string hash
+    unsigned int hash = 5381;
+    while (*name) {
+        hash = ((hash << 5) + hash) + (unsigned char)*name++;
+    }
+    return hash % PATH_CACHE_BUCKETS;
+}
+
+/**
+ * @brief Free the cached PATH directory table
+ */
+static void path_cache_free_dirs(void) {
+    for (int i = 0; i < num_cached_dirs; i++) {
+        free(cached_dirs[i]);
+    }
+    free(cached_dirs);
+    free(cached_dir_mtimes);
+    cached_dirs = NULL;
+    cached_dir_mtimes = NULL;
+    num_cached_dirs = 0;
+}
+
+/**
+ * @brief Clear the executable cache
+ *
+ * Drops all cached PATH lookup results. The cache is rebuilt lazily
+ * on the next path_search_cached() call.
+ */
+void path_cache_clear(void) {
+    for (int i = 0; i < PATH_CACHE_BUCKETS; i++) {
+        PathCacheEntry *entry = path_cache[i];
+        while (entry) {
+            PathCacheEntry *next = entry->next;
+            // name and full_path are interned - the pool owns them
+            free(entry);
+            entry = next;
+        }
+        path_cache[i] = NULL;
+    }
+
+    free(cached_path_env);
+    cached_path_env = NULL;
+    path_cache_free_dirs();
+}
+
+/**
+ * @brief Drop cache entries affected by a changed directory
+ *
+ * An executable added to a directory can shadow entries resolved from
+ * any directory later in PATH order, so everything at or past the
+ * changed index is dropped, along with all negative entries.
+ *
+ * @param dir_index Index of the changed directory in cached_dirs
+ */
+static void path_cache_invalidate_from(int dir_index) {
+    for (int i = 0; i < PATH_CACHE_BUCKETS; i++) {
+        PathCacheEntry **link = &path_cache[i];
+        while (*link) {
+            PathCacheEntry *entry = *link;
+            if (entry->full_path == NULL || entry->dir_index >= dir_index) {
+                *link = entry->next;
+                free(entry);
+            } else {
+                link = &entry->next;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Build the PATH directory table
+ *
+ * Splits $PATH into directories and records each directory's mtime.
+ *
+ * @param path_env Value of $PATH to index
+ * @return int 0 on success, non-zero on error
+ */
+static int path_cache_load_dirs(const char *path_env) {
+    char *path_copy = strdup(path_env);
+    if (!path_copy) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+
+    // Count directories
+    int count = 1;
+    for (const char *p = path_env; *p; p++) {
+        if (*p == ':') count++;
+    }
+
+    cached_dirs = malloc(count * sizeof(char *));
+    cached_dir_mtimes = malloc(count * sizeof(time_t));
+    if (!cached_dirs || !cached_dir_mtimes) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        free(path_copy);
+        path_cache_free_dirs();
+        return -1;
+    }
+
+    // Record each directory and its current mtime
+    num_cached_dirs = 0;
+    char *dir = strtok(path_copy, ":");
+    while (dir != NULL && num_cached_dirs < count) {
+        cached_dirs[num_cached_dirs] = strdup(dir);
+        if (!cached_dirs[num_cached_dirs]) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            free(path_copy);
+            path_cache_free_dirs();
+            return -1;
+        }
+
+        struct stat st;
+        cached_dir_mtimes[num_cached_dirs] =
+            (stat(dir, &st) == 0) ? st.st_mtime : 0;
+        num_cached_dirs++;
+
+        dir = strtok(NULL, ":");
+    }
+
+    free(path_copy);
+    return 0;
+}
+
+/**
+ * @brief Validate the executable cache
+ *
+ * Rebuilds the cache if $PATH changed, and drops stale entries when a
+ * PATH directory's mtime changed. mtime checks are throttled so bursts
+ * of lookups pay for at most one stat pass per second.
+ *
+ * @return int 0 if the cache is usable, non-zero on error
+ */
+static int path_cache_validate(void) {
+    char *path_env = getenv("PATH");
+    if (!path_env) {
+        path_cache_clear();
+        return -1;
+    }
+
+    // Full flush if $PATH itself changed (or first use)
+    if (!cached_path_env || strcmp(cached_path_env, path_env) != 0) {
+        path_cache_clear();
+        cached_path_env = strdup(path_env);
+        if (!cached_path_env) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return -1;
+        }
+        if (path_cache_load_dirs(path_env) != 0) {
+            return -1;
+        }
+        last_validation_time = time(NULL);
+        return 0;
+    }
+
+    // Throttled per-directory mtime revalidation
+    time_t now = time(NULL);
+    if (now - last_validation_time < PATH_CACHE_CHECK_INTERVAL) {
+        return 0;
+    }
+    last_validation_time = now;
+
+    for (int i = 0; i < num_cached_dirs; i++) {
+        struct stat st;
+        time_t mtime = (stat(cached_dirs[i], &st) == 0) ? st.st_mtime : 0;
+        if (mtime != cached_dir_mtimes[i]) {
+            cached_dir_mtimes[i] = mtime;
+            path_cache_invalidate_from(i);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Insert a lookup result into the executable cache
+ *
+ * Both strings are interned, so entries cost one malloc and repeated
+ * insertions of the same name or path store no new bytes.
+ *
+ * @param name Executable name
+ * @param full_path Interned resolved path, or NULL for a negative entry
+ * @param dir_index Index of the resolving directory (-1 for negative)
+ */
+static void path_cache_insert(const char *name, const char *full_path, int dir_index) {
+    PathCacheEntry *entry = malloc(sizeof(PathCacheEntry));
+    if (!entry) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return;
+    }
+
+    entry->name = str_intern(name, strlen(name));
+    entry->full_path = full_path;
+    entry->dir_index = dir_index;
+
+    if (!entry->name) {
+        free(entry);
+        return;
+    }
+
+    unsigned int bucket = path_cache_hash(name);
+    entry->next = path_cache[bucket];
+    path_cache[bucket] = entry;
+}
+
+/**
+ * @brief Search for file in PATH using the executable cache
+ *
+ * Like path_search(), but answers from an in-memory index of
+ * executable name to resolved path. Cache entries are invalidated
+ * when $PATH changes or a PATH directory's mtime changes, and
+ * lookups that found nothing are remembered in a negative cache so
+ * repeated misses do not re-walk every PATH directory.
+ *
+ * The result is interned: a cache hit costs no allocation, and when
+ * the caller passes an interned name (parse_command interns argv[0])
+ * the key comparison is a single pointer check.
+ *
+ * @param filename File name to search for
+ * @return const char* Interned full path if found (do not free), NULL otherwise
+ */
+const char *path_search_cached(const char *filename) {
+    if (!filename) {
+        return NULL;
+    }
+
+    // If filename contains a slash, it's a path - don't cache those
+    if (strchr(filename, '/') != NULL) {
+        if (path_exists(filename) && path_is_executable(filename)) {
+            return str_intern(filename, strlen(filename));
+        }
+        return NULL;
+    }
+
+    if (path_cache_validate() != 0) {
+        // Cache unusable (no $PATH or allocation failure) - fall back
+        char *found = path_search(filename);
+        if (!found) {
+            return NULL;
+        }
+        const char *interned = str_intern(found, strlen(found));
+        free(found);
+        return interned;
+    }
+
+    // Look for a cached result (positive or negative); interned
+    // callers hit on the pointer comparison alone
+    unsigned int bucket = path_cache_hash(filename);
+    for (PathCacheEntry *entry = path_cache[bucket]; entry; entry = entry->next) {
+        if (entry->name == filename || strcmp(entry->name, filename) == 0) {
+            return entry->full_path;
+        }
+    }
+
+    // Miss - probe the PATH directories once and remember the outcome
+    for (int i = 0; i < num_cached_dirs; i++) {
+        char *full_path = path_join(cached_dirs[i], filename);
+        if (!full_path) {
+            continue;
+        }
+
+        if (path_exists(full_path) && path_is_executable(full_path)) {
+            const char *interned = str_intern(full_path, strlen(full_path));
+            free(full_path);
+            if (!interned) {
+                return NULL;
+            }
+            path_cache_insert(filename, interned, i);
+            return interned;
+        }
+
+        free(full_path);
+    }
+
+    // Not found anywhere - record a negative entry
+    path_cache_insert(filename, NULL, -1);
+    return NULL;
+}
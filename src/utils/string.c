@@ -129,9 +129,14 @@ char *str_trim(char *str) {
     
     // First trim right to remove trailing whitespace
     str_trim_right(str);
-    
-    // Then return the result of trimming left
-    return str_trim_left(str);
+
+    // Then shift the string left over any leading whitespace
+    char *start = str_trim_left(str);
+    if (start != str) {
+        memmove(str, start, strlen(start) + 1);
+    }
+
+    return str;
 }
 
 /**
@@ -628,4 +633,298 @@ int str_ncasecmp(const char *s1, const char *s2, size_t n) {
     } while (1);
     
     return c1 - c2;
-}
\ No newline at end of file
+}
+// Default initial capacity for string builders; covers typical
+// arguments without a second allocation
+#define STR_BUILDER_DEFAULT_CAPACITY 64
+
+/**
+ * @brief Initialize a string builder
+ * 
+ * @param sb Builder to initialize
+ * @param initial_capacity Initial allocation (0 for the default)
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_init(StrBuilder *sb, size_t initial_capacity) {
+    if (!sb) {
+        return -1;
+    }
+    
+    if (initial_capacity == 0) {
+        initial_capacity = STR_BUILDER_DEFAULT_CAPACITY;
+    }
+    
+    sb->data = malloc(initial_capacity);
+    if (!sb->data) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+    
+    sb->data[0] = '\0';
+    sb->length = 0;
+    sb->capacity = initial_capacity;
+    return 0;
+}
+
+/**
+ * @brief Ensure room for additional bytes
+ * 
+ * Doubles the buffer until the requested extra bytes (plus the NUL)
+ * fit, so repeated appends cost amortized O(1).
+ * 
+ * @param sb Builder to grow
+ * @param extra Bytes about to be appended
+ * @return int 0 on success, non-zero on error
+ */
+static int str_builder_reserve(StrBuilder *sb, size_t extra) {
+    if (sb->length + extra + 1 <= sb->capacity) {
+        return 0;
+    }
+    
+    // A detached builder has capacity 0; restart from the default
+    size_t new_capacity =
+        sb->capacity > 0 ? sb->capacity : STR_BUILDER_DEFAULT_CAPACITY;
+    while (sb->length + extra + 1 > new_capacity) {
+        new_capacity *= 2;
+    }
+    
+    char *new_data = realloc(sb->data, new_capacity);
+    if (!new_data) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
+    }
+    
+    sb->data = new_data;
+    sb->capacity = new_capacity;
+    return 0;
+}
+
+/**
+ * @brief Append one character
+ * 
+ * @param sb Builder to append to
+ * @param c Character to append
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_append_char(StrBuilder *sb, char c) {
+    // A NULL buffer (detached builder) is fine: reserve reallocates
+    if (!sb) {
+        return -1;
+    }
+    
+    if (str_builder_reserve(sb, 1) != 0) {
+        return -1;
+    }
+    
+    sb->data[sb->length++] = c;
+    sb->data[sb->length] = '\0';
+    return 0;
+}
+
+/**
+ * @brief Append a counted byte range
+ * 
+ * @param sb Builder to append to
+ * @param str Bytes to append
+ * @param n Number of bytes
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_append_n(StrBuilder *sb, const char *str, size_t n) {
+    // A NULL buffer (detached builder) is fine: reserve reallocates
+    if (!sb || !str) {
+        return -1;
+    }
+    
+    if (str_builder_reserve(sb, n) != 0) {
+        return -1;
+    }
+    
+    memcpy(sb->data + sb->length, str, n);
+    sb->length += n;
+    sb->data[sb->length] = '\0';
+    return 0;
+}
+
+/**
+ * @brief Append a NUL-terminated string
+ * 
+ * @param sb Builder to append to
+ * @param str String to append
+ * @return int 0 on success, non-zero on error
+ */
+int str_builder_append(StrBuilder *sb, const char *str) {
+    if (!str) {
+        return -1;
+    }
+    return str_builder_append_n(sb, str, strlen(str));
+}
+
+/**
+ * @brief Reset a builder to empty without releasing its buffer
+ * 
+ * @param sb Builder to clear
+ */
+void str_builder_clear(StrBuilder *sb) {
+    if (sb && sb->data) {
+        sb->data[0] = '\0';
+        sb->length = 0;
+    }
+}
+
+/**
+ * @brief Take ownership of the built string
+ * 
+ * @param sb Builder to detach from
+ * @return char* Built string (caller must free), NULL if empty builder
+ */
+char *str_builder_detach(StrBuilder *sb) {
+    if (!sb) {
+        return NULL;
+    }
+    
+    char *data = sb->data;
+    sb->data = NULL;
+    sb->length = 0;
+    sb->capacity = 0;
+    return data;
+}
+
+/**
+ * @brief Release a builder's buffer
+ * 
+ * @param sb Builder to free
+ */
+void str_builder_free(StrBuilder *sb) {
+    if (sb) {
+        free(sb->data);
+        sb->data = NULL;
+        sb->length = 0;
+        sb->capacity = 0;
+    }
+}
+
+// Bucket count for the intern table; chains stay short for the few
+// thousand distinct strings a session sees
+#define INTERN_BUCKETS 1024
+
+// Payload size of one storage chunk; entries are carved out of these
+// append-only blocks, so interning never frees or moves a string
+#define INTERN_CHUNK_SIZE (64 * 1024)
+
+/**
+ * @brief One interned string
+ *
+ * Header and bytes live together in a storage chunk.
+ */
+typedef struct InternEntry {
+    struct InternEntry *next;   /**< Bucket chain */
+    size_t len;                 /**< String length (excluding the NUL) */
+    char str[];                 /**< NUL-terminated bytes */
+} InternEntry;
+
+/**
+ * @brief One append-only storage chunk
+ */
+typedef struct InternChunk {
+    struct InternChunk *next;   /**< Previously filled chunk */
+    size_t used;                /**< Bytes handed out so far */
+    char data[];                /**< Chunk payload */
+} InternChunk;
+
+static InternEntry *intern_buckets[INTERN_BUCKETS];
+static InternChunk *intern_chunks = NULL;
+
+/**
+ * @brief Hash a counted byte range
+ *
+ * @param str Bytes to hash
+ * @param len Number of bytes
+ * @return unsigned int Bucket index
+ */
+static unsigned int intern_hash(const char *str, size_t len) {
+    // djb2, the same hash the executable cache uses
+    unsigned int hash = 5381;
+    for (size_t i = 0; i < len; i++) {
+        hash = ((hash << 5) + hash) + (unsigned char)str[i];
+    }
+    return hash % INTERN_BUCKETS;
+}
+
+/**
+ * @brief Carve bytes out of the current storage chunk
+ *
+ * Starts a new chunk when the current one is full; a request larger
+ * than the standard payload gets a chunk of its own.
+ *
+ * @param size Number of bytes needed
+ * @return void* Pointer to the bytes, NULL on allocation failure
+ */
+static void *intern_chunk_alloc(size_t size) {
+    // Keep every entry header pointer-aligned within the chunk
+    size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+    if (!intern_chunks || intern_chunks->used + size > INTERN_CHUNK_SIZE) {
+        size_t payload = size > INTERN_CHUNK_SIZE ? size : INTERN_CHUNK_SIZE;
+        InternChunk *chunk = malloc(sizeof(InternChunk) + payload);
+        if (!chunk) {
+            ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+            return NULL;
+        }
+        chunk->next = intern_chunks;
+        chunk->used = 0;
+        intern_chunks = chunk;
+    }
+
+    void *result = intern_chunks->data + intern_chunks->used;
+    intern_chunks->used += size;
+    return result;
+}
+
+/**
+ * @brief Intern a string
+ *
+ * Returns the canonical copy of the given bytes; every call with
+ * equal contents returns the same pointer.
+ *
+ * @param str Bytes to intern (need not be NUL-terminated)
+ * @param len Number of bytes
+ * @return const char* Canonical NUL-terminated copy, NULL on allocation failure
+ */
+const char *str_intern(const char *str, size_t len) {
+    if (!str) {
+        return NULL;
+    }
+
+    unsigned int bucket = intern_hash(str, len);
+    for (InternEntry *entry = intern_buckets[bucket]; entry; entry = entry->next) {
+        if (entry->len == len && memcmp(entry->str, str, len) == 0) {
+            return entry->str;
+        }
+    }
+
+    InternEntry *entry = intern_chunk_alloc(sizeof(InternEntry) + len + 1);
+    if (!entry) {
+        return NULL;
+    }
+
+    entry->len = len;
+    memcpy(entry->str, str, len);
+    entry->str[len] = '\0';
+    entry->next = intern_buckets[bucket];
+    intern_buckets[bucket] = entry;
+    return entry->str;
+}
+
+/**
+ * @brief Release the intern pool
+ */
+void str_intern_destroy(void) {
+    InternChunk *chunk = intern_chunks;
+    while (chunk) {
+        InternChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    intern_chunks = NULL;
+    memset(intern_buckets, 0, sizeof(intern_buckets));
+}
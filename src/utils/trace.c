@@ -0,0 +1,290 @@
+/**
+ * @file trace.c
+ * @brief Hot-path latency tracing implementation
+ *
+ * Each stage keeps a histogram of span durations in log2-ns buckets,
+ * so recording a span is a clock read, a bit scan, and an increment -
+ * cheap enough to leave compiled in and gated by one cached branch.
+ */
+
+#include "utils/trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** Number of log2 buckets: bucket i covers [2^i, 2^(i+1)) ns */
+#define TRACE_NUM_BUCKETS 40
+
+/**
+ * @brief Per-stage histogram
+ */
+typedef struct {
+    long count;                        /**< Number of spans */
+    long total_ns;                     /**< Sum of span durations */
+    long max_ns;                       /**< Longest span */
+    long buckets[TRACE_NUM_BUCKETS];   /**< log2 duration buckets */
+} TraceHistogram;
+
+static TraceHistogram histograms[TRACE_STAGE_COUNT];
+
+/**
+ * @brief Accumulated per-command resource usage
+ */
+typedef struct {
+    long count;        /**< Commands recorded */
+    long wall_ns;      /**< Total wall-clock time */
+    long user_us;      /**< Total user CPU time */
+    long sys_us;       /**< Total system CPU time */
+    long minflt;       /**< Total minor page faults */
+    long majflt;       /**< Total major page faults */
+    long peak_rss_kb;  /**< Largest child max-RSS seen */
+} RusageTotals;
+
+static RusageTotals rusage_totals;
+
+// Stage names, in TraceStage order
+static const char *stage_names[TRACE_STAGE_COUNT] = {
+    "parse_chain",
+    "tokenize",
+    "builtin_lookup",
+    "builtin_run",
+    "spawn",
+    "wait",
+    "pipeline",
+    "completion",
+};
+
+/**
+ * @brief Check whether tracing is enabled
+ *
+ * @return int 1 if tracing is enabled, 0 otherwise
+ */
+int trace_enabled(void) {
+    static int enabled = -1;
+
+    if (enabled == -1) {
+        char *value = getenv("CSHELL_TRACE");
+        enabled = (value != NULL && strcmp(value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+/**
+ * @brief Read the monotonic clock in nanoseconds
+ *
+ * @return long Current time in ns
+ */
+static long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/**
+ * @brief Start a span
+ *
+ * @return long Start timestamp in ns, or 0 when tracing is disabled
+ */
+long trace_begin(void) {
+    if (!trace_enabled()) {
+        return 0;
+    }
+    return now_ns();
+}
+
+/**
+ * @brief End a span and record it
+ *
+ * @param stage Stage the span belongs to
+ * @param start Timestamp returned by trace_begin()
+ */
+void trace_end(TraceStage stage, long start) {
+    if (start == 0 || stage >= TRACE_STAGE_COUNT) {
+        return;
+    }
+
+    long duration = now_ns() - start;
+    if (duration < 0) duration = 0;
+
+    // Find the log2 bucket
+    int bucket = 0;
+    for (long d = duration; d > 1 && bucket < TRACE_NUM_BUCKETS - 1; d >>= 1) {
+        bucket++;
+    }
+
+    TraceHistogram *hist = &histograms[stage];
+    hist->count++;
+    hist->total_ns += duration;
+    if (duration > hist->max_ns) hist->max_ns = duration;
+    hist->buckets[bucket]++;
+}
+
+/**
+ * @brief Approximate a percentile from a histogram
+ *
+ * Walks the buckets until the cumulative count crosses the target
+ * rank and returns the bucket's upper bound.
+ *
+ * @param hist Histogram to read
+ * @param percentile Percentile to approximate (0-100)
+ * @return long Approximate latency in ns
+ */
+static long histogram_percentile(const TraceHistogram *hist, int percentile) {
+    long rank = (hist->count * percentile + 99) / 100;
+    long cumulative = 0;
+
+    for (int i = 0; i < TRACE_NUM_BUCKETS; i++) {
+        cumulative += hist->buckets[i];
+        if (cumulative >= rank) {
+            return 1L << (i + 1);
+        }
+    }
+
+    return hist->max_ns;
+}
+
+/**
+ * @brief Format a nanosecond value into a short human-readable string
+ *
+ * @param ns Duration in nanoseconds
+ * @param buf Output buffer
+ * @param size Buffer size
+ * @return const char* The output buffer
+ */
+static const char *format_ns(long ns, char *buf, size_t size) {
+    if (ns >= 1000000000L) {
+        snprintf(buf, size, "%.2fs", ns / 1e9);
+    } else if (ns >= 1000000L) {
+        snprintf(buf, size, "%.2fms", ns / 1e6);
+    } else if (ns >= 1000L) {
+        snprintf(buf, size, "%.1fus", ns / 1e3);
+    } else {
+        snprintf(buf, size, "%ldns", ns);
+    }
+    return buf;
+}
+
+/**
+ * @brief Dump all stage histograms
+ *
+ * @param fp Output stream
+ */
+void trace_dump(FILE *fp) {
+    if (!trace_enabled()) {
+        fprintf(fp, "tracing disabled (set CSHELL_TRACE=1 to enable)\n");
+        return;
+    }
+
+    char b1[32], b2[32], b3[32], b4[32];
+    int any = 0;
+
+    fprintf(fp, "%-16s %8s %10s %10s %10s %10s\n",
+            "stage", "count", "mean", "p50", "p99", "max");
+
+    for (int i = 0; i < TRACE_STAGE_COUNT; i++) {
+        const TraceHistogram *hist = &histograms[i];
+        if (hist->count == 0) {
+            continue;
+        }
+        any = 1;
+
+        fprintf(fp, "%-16s %8ld %10s %10s %10s %10s\n",
+                stage_names[i], hist->count,
+                format_ns(hist->total_ns / hist->count, b1, sizeof(b1)),
+                format_ns(histogram_percentile(hist, 50), b2, sizeof(b2)),
+                format_ns(histogram_percentile(hist, 99), b3, sizeof(b3)),
+                format_ns(hist->max_ns, b4, sizeof(b4)));
+    }
+
+    if (!any) {
+        fprintf(fp, "(no spans recorded)\n");
+    }
+}
+
+/**
+ * @brief Reset all histograms
+ */
+void trace_reset(void) {
+    memset(histograms, 0, sizeof(histograms));
+    memset(&rusage_totals, 0, sizeof(rusage_totals));
+}
+
+/**
+ * @brief Check whether per-command resource recording is enabled
+ *
+ * @return int 1 if recording is enabled, 0 otherwise
+ */
+int rusage_enabled(void) {
+    static int enabled = -1;
+
+    if (enabled == -1) {
+        char *value = getenv("CSHELL_RUSAGE");
+        enabled = (value != NULL && strcmp(value, "0") != 0);
+    }
+
+    return enabled;
+}
+
+/**
+ * @brief Convert a timeval to microseconds
+ *
+ * @param tv Timeval to convert
+ * @return long Value in microseconds
+ */
+static long timeval_us(const struct timeval *tv) {
+    return tv->tv_sec * 1000000L + tv->tv_usec;
+}
+
+/**
+ * @brief Record one foreground command's resource usage
+ *
+ * @param before Children rusage before the command was launched
+ * @param after Children rusage after the command was reaped
+ * @param wall_ns Wall-clock duration of the command in ns
+ */
+void trace_record_rusage(const struct rusage *before,
+                         const struct rusage *after, long wall_ns) {
+    if (!rusage_enabled() || !before || !after) {
+        return;
+    }
+
+    rusage_totals.count++;
+    rusage_totals.wall_ns += wall_ns;
+    rusage_totals.user_us += timeval_us(&after->ru_utime) - timeval_us(&before->ru_utime);
+    rusage_totals.sys_us += timeval_us(&after->ru_stime) - timeval_us(&before->ru_stime);
+    rusage_totals.minflt += after->ru_minflt - before->ru_minflt;
+    rusage_totals.majflt += after->ru_majflt - before->ru_majflt;
+
+    // ru_maxrss is a high-water mark over all children, not a delta
+    if (after->ru_maxrss > rusage_totals.peak_rss_kb) {
+        rusage_totals.peak_rss_kb = after->ru_maxrss;
+    }
+}
+
+/**
+ * @brief Dump accumulated per-command resource usage
+ *
+ * @param fp Output stream
+ */
+void trace_rusage_dump(FILE *fp) {
+    if (!rusage_enabled()) {
+        fprintf(fp, "resource recording disabled (set CSHELL_RUSAGE=1 to enable)\n");
+        return;
+    }
+
+    if (rusage_totals.count == 0) {
+        fprintf(fp, "(no commands recorded)\n");
+        return;
+    }
+
+    char b1[32];
+    fprintf(fp, "resource usage over %ld command%s:\n",
+            rusage_totals.count, rusage_totals.count == 1 ? "" : "s");
+    fprintf(fp, "  wall    %s\n", format_ns(rusage_totals.wall_ns, b1, sizeof(b1)));
+    fprintf(fp, "  user    %s\n", format_ns(rusage_totals.user_us * 1000L, b1, sizeof(b1)));
+    fprintf(fp, "  sys     %s\n", format_ns(rusage_totals.sys_us * 1000L, b1, sizeof(b1)));
+    fprintf(fp, "  faults  %ld minor / %ld major\n",
+            rusage_totals.minflt, rusage_totals.majflt);
+    fprintf(fp, "  maxrss  %ld KB (peak child)\n", rusage_totals.peak_rss_kb);
+}
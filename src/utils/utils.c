@@ -1,225 +1,233 @@
 /**
- * @file memory.c
- * @brief Memory management implementation
+ * @file utils.c
+ * @brief Utility functions implementation
  *
- * Implementation of memory management functions.
+ * Implementation of general-purpose utility functions.
  */
 
-#include "utils/memory.h"
+#include "utils/utils.h"
 #include "utils/error.h"
+#include "utils/path.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <errno.h>
 
-// Memory statistics (for debug builds)
-#ifdef DEBUG
-static size_t total_allocations = 0;
-static size_t total_bytes_allocated = 0;
-static size_t current_bytes_allocated = 0;
-static size_t peak_bytes_allocated = 0;
-#endif
+/** Global verbose flag (declared in shell.h) */
+int g_verbose_mode = 0;
 
 /**
- * @brief Safe malloc
- * 
- * Allocates memory with error checking.
- * 
- * @param size Size to allocate
- * @return void* Allocated memory
+ * @brief Safe string copy
+ *
+ * Copies a string with boundary checks.
+ *
+ * @param dest Destination buffer
+ * @param src Source string
+ * @param size Buffer size
+ * @return char* Destination buffer
  */
-void *safe_malloc(size_t size) {
-    if (size == 0) {
-        return NULL;
-    }
-    
-    void *ptr = malloc(size);
-    
-    if (!ptr) {
-        ERROR_ERROR(ERR_MEMORY, "Failed to allocate %zu bytes", size);
-        return NULL;
+char *safe_strcpy(char *dest, const char *src, size_t size) {
+    if (!dest || !src || size == 0) {
+        return dest;
     }
-    
-#ifdef DEBUG
-    total_allocations++;
-    total_bytes_allocated += size;
-    current_bytes_allocated += size;
-    
-    if (current_bytes_allocated > peak_bytes_allocated) {
-        peak_bytes_allocated = current_bytes_allocated;
+
+    size_t i;
+    for (i = 0; i < size - 1 && src[i] != '\0'; i++) {
+        dest[i] = src[i];
     }
-#endif
-    
-    return ptr;
+    dest[i] = '\0';
+
+    return dest;
 }
 
 /**
- * @brief Safe calloc
- * 
- * Allocates and zeroes memory with error checking.
- * 
- * @param nmemb Number of elements
- * @param size Size of each element
- * @return void* Allocated memory
+ * @brief Safe string concatenation
+ *
+ * Concatenates strings with boundary checks.
+ *
+ * @param dest Destination buffer
+ * @param src Source string
+ * @param size Buffer size
+ * @return char* Destination buffer
  */
-void *safe_calloc(size_t nmemb, size_t size) {
-    if (nmemb == 0 || size == 0) {
-        return NULL;
-    }
-    
-    // Check for overflow
-    if (nmemb > SIZE_MAX / size) {
-        ERROR_ERROR(ERR_MEMORY, "Integer overflow in calloc(%zu, %zu)", nmemb, size);
-        return NULL;
+char *safe_strcat(char *dest, const char *src, size_t size) {
+    if (!dest || !src || size == 0) {
+        return dest;
     }
-    
-    void *ptr = calloc(nmemb, size);
-    
-    if (!ptr) {
-        ERROR_ERROR(ERR_MEMORY, "Failed to allocate %zu bytes", nmemb * size);
-        return NULL;
-    }
-    
-#ifdef DEBUG
-    total_allocations++;
-    total_bytes_allocated += nmemb * size;
-    current_bytes_allocated += nmemb * size;
-    
-    if (current_bytes_allocated > peak_bytes_allocated) {
-        peak_bytes_allocated = current_bytes_allocated;
+
+    size_t dest_len = strlen(dest);
+    if (dest_len >= size - 1) {
+        return dest;
     }
-#endif
-    
-    return ptr;
+
+    safe_strcpy(dest + dest_len, src, size - dest_len);
+    return dest;
 }
 
 /**
- * @brief Safe realloc
- * 
- * Reallocates memory with error checking.
- * 
- * @param ptr Pointer to reallocate
- * @param size New size
- * @return void* Reallocated memory
+ * @brief Duplicate a string
+ *
+ * Duplicates a string (caller must free).
+ *
+ * @param str String to duplicate
+ * @return char* Duplicated string
  */
-void *safe_realloc(void *ptr, size_t size) {
-    if (size == 0) {
-        free(ptr);
+char *safe_strdup(const char *str) {
+    if (!str) {
         return NULL;
     }
-    
-    // If ptr is NULL, equivalent to malloc
-    if (!ptr) {
-        return safe_malloc(size);
-    }
-    
-#ifdef DEBUG
-    // Get the old size - not possible in standard C without tracking
-    // For now, just count as a new allocation
-    total_allocations++;
-    total_bytes_allocated += size;
-    current_bytes_allocated += size;
-    
-    if (current_bytes_allocated > peak_bytes_allocated) {
-        peak_bytes_allocated = current_bytes_allocated;
-    }
-#endif
-    
-    void *new_ptr = realloc(ptr, size);
-    
-    if (!new_ptr) {
-        ERROR_ERROR(ERR_MEMORY, "Failed to reallocate %zu bytes", size);
-        return NULL;
+
+    char *result = strdup(str);
+    if (!result) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
     }
-    
-    return new_ptr;
+
+    return result;
 }
 
 /**
- * @brief Safe free
- * 
- * Frees memory and sets pointer to NULL.
- * 
- * @param pptr Pointer to pointer to free
+ * @brief Free string array
+ *
+ * Frees an array of strings (e.g., as returned by str_split).
+ *
+ * @param parts Array of strings
+ * @param count Number of parts
  */
-void safe_free(void **pptr) {
-    if (!pptr || !*pptr) {
+void free_str_array(char **parts, int count) {
+    if (!parts) {
         return;
     }
-    
-#ifdef DEBUG
-    // No way to know the size of the allocation being freed in standard C
-#endif
-    
-    free(*pptr);
-    *pptr = NULL;
+
+    for (int i = 0; i < count; i++) {
+        free(parts[i]);
+    }
+
+    free(parts);
 }
 
 /**
- * @brief Duplicate memory block
- * 
- * Duplicates a memory block.
- * 
- * @param src Source pointer
- * @param size Size to duplicate
- * @return void* Duplicated memory
+ * @brief Expand tilde in path
+ *
+ * Expands ~ to home directory in a path.
+ *
+ * @param path Path to expand
+ * @return char* Expanded path (caller must free)
  */
-void *mem_dup(const void *src, size_t size) {
-    if (!src || size == 0) {
-        return NULL;
+char *expand_tilde(const char *path) {
+    return path_expand(path);
+}
+
+/**
+ * @brief Get absolute path
+ *
+ * Converts a path to absolute path.
+ *
+ * @param path Path to convert
+ * @return char* Absolute path (caller must free)
+ */
+char *get_absolute_path(const char *path) {
+    return path_absolute(path);
+}
+
+/**
+ * @brief Create directory path
+ *
+ * Creates a directory path (including parent directories).
+ *
+ * @param path Path to create
+ * @param mode Directory permissions
+ * @return int 0 on success, -1 on error
+ */
+int create_path(const char *path, mode_t mode) {
+    if (!path || *path == '\0') {
+        return -1;
     }
-    
-    void *dest = safe_malloc(size);
-    if (!dest) {
-        return NULL;
+
+    // Make a copy we can modify while walking the components
+    char *path_copy = strdup(path);
+    if (!path_copy) {
+        ERROR_ERROR(ERR_MEMORY, "Memory allocation error");
+        return -1;
     }
-    
-    memcpy(dest, src, size);
-    return dest;
+
+    // Create each component in turn
+    for (char *p = path_copy + 1; *p != '\0'; p++) {
+        if (*p == '/') {
+            *p = '\0';
+
+            if (mkdir(path_copy, mode) != 0 && errno != EEXIST) {
+                ERROR_SYSTEM(ERR_IO, "Failed to create directory: %s", path_copy);
+                free(path_copy);
+                return -1;
+            }
+
+            *p = '/';
+        }
+    }
+
+    // Create the final component
+    if (mkdir(path_copy, mode) != 0 && errno != EEXIST) {
+        ERROR_SYSTEM(ERR_IO, "Failed to create directory: %s", path_copy);
+        free(path_copy);
+        return -1;
+    }
+
+    free(path_copy);
+    return 0;
 }
 
 /**
- * @brief Allocate memory for string of specified length
- * 
- * @param len String length (not including null terminator)
- * @return char* Allocated memory
+ * @brief Check if file exists
+ *
+ * @param path File path
+ * @return int 1 if exists, 0 otherwise
  */
-char *str_alloc(size_t len) {
-    return (char *)safe_malloc(len + 1);
+int file_exists(const char *path) {
+    return path_exists(path);
 }
 
 /**
- * @brief Debug memory allocation
- * 
- * Allocates memory with debugging information.
- * 
- * @param size Size to allocate
- * @param file Source file
- * @param line Line number
- * @return void* Allocated memory
+ * @brief Print error message
+ *
+ * Prints an error message to stderr.
+ *
+ * @param format Format string
+ * @param ... Additional arguments
  */
-void *debug_malloc(size_t size, const char *file, int line) {
-    void *ptr = safe_malloc(size);
-    
-    if (ptr) {
-        ERROR_DEBUG(file, line, "debug_malloc", "Allocated %zu bytes at %p", size, ptr);
+void print_error(const char *format, ...) {
+    if (!format) {
+        return;
     }
-    
-    return ptr;
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+
+    fprintf(stderr, "\n");
 }
 
 /**
- * @brief Print memory statistics
- * 
- * Prints memory allocation statistics (debug build only).
+ * @brief Print debug message
+ *
+ * Prints a debug message if verbose mode is enabled.
+ *
+ * @param format Format string
+ * @param ... Additional arguments
  */
-void print_memory_stats(void) {
-#ifdef DEBUG
-    printf("Memory statistics:\n");
-    printf("  Total allocations: %zu\n", total_allocations);
-    printf("  Total bytes allocated: %zu\n", total_bytes_allocated);
-    printf("  Current bytes allocated: %zu\n", current_bytes_allocated);
-    printf("  Peak bytes allocated: %zu\n", peak_bytes_allocated);
-#else
-    printf("Memory statistics only available in debug build\n");
-#endif
-}
\ No newline at end of file
+void print_debug(const char *format, ...) {
+    if (!format || !g_verbose_mode) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "[DEBUG] ");
+    vfprintf(stderr, format, args);
+    va_end(args);
+
+    fprintf(stderr, "\n");
+}
@@ -0,0 +1,136 @@
+#include "test_framework.h"
+#include "test_runner.h"
+#include "../../include/completion/matcher.h"
+#include "../../include/completion/completion.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Unit tests for the completion matcher
+ */
+
+// Test basic prefix matching
+TestResult test_prefix_match() {
+    ASSERT_EQUAL(1, prefix_match("echo", "ec"));
+    ASSERT_EQUAL(1, prefix_match("echo", ""));
+    ASSERT_EQUAL(0, prefix_match("echo", "ech0"));
+    ASSERT_EQUAL(0, prefix_match("ec", "echo"));
+
+    return TEST_PASSED;
+}
+
+// Test incremental narrowing of the match set
+TestResult test_incremental_narrowing() {
+    const char *candidates[] = {"make clean", "git status", "git stash", "ls -la"};
+    IncrementalMatcher im;
+
+    int result = incremental_matcher_init(&im, candidates, 4);
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(4, im.num_matches);
+
+    // "g" keeps only the git commands
+    ASSERT_EQUAL(2, incremental_matcher_push(&im, 'g'));
+    ASSERT_EQUAL(2, incremental_matcher_push(&im, 'i'));
+    ASSERT_EQUAL(2, incremental_matcher_push(&im, 't'));
+
+    // "git sta" still matches both, "git stat" only one
+    incremental_matcher_push(&im, ' ');
+    incremental_matcher_push(&im, 's');
+    incremental_matcher_push(&im, 't');
+    ASSERT_EQUAL(2, incremental_matcher_push(&im, 'a'));
+    ASSERT_EQUAL(1, incremental_matcher_push(&im, 't'));
+    ASSERT_EQUAL(1, im.matches[0]);
+
+    incremental_matcher_free(&im);
+    return TEST_PASSED;
+}
+
+// Test that backspace widens the match set again
+TestResult test_incremental_widening() {
+    const char *candidates[] = {"echo one", "echo two", "cat file"};
+    IncrementalMatcher im;
+
+    ASSERT_EQUAL(0, incremental_matcher_init(&im, candidates, 3));
+
+    incremental_matcher_push(&im, 'o');
+    ASSERT_EQUAL(1, incremental_matcher_push(&im, 'n'));
+
+    // Popping "n" restores both echo matches, popping "o" everything
+    ASSERT_EQUAL(2, incremental_matcher_pop(&im));
+    ASSERT_EQUAL(3, incremental_matcher_pop(&im));
+
+    // Popping an empty query is a no-op
+    ASSERT_EQUAL(3, incremental_matcher_pop(&im));
+
+    incremental_matcher_free(&im);
+    return TEST_PASSED;
+}
+
+// Test matching in the middle of a candidate
+TestResult test_substring_match() {
+    const char *candidates[] = {"tail -f /var/log/syslog", "ls"};
+    IncrementalMatcher im;
+
+    ASSERT_EQUAL(0, incremental_matcher_init(&im, candidates, 2));
+
+    incremental_matcher_push(&im, 'l');
+    incremental_matcher_push(&im, 'o');
+    ASSERT_EQUAL(1, incremental_matcher_push(&im, 'g'));
+    ASSERT_EQUAL(0, im.matches[0]);
+
+    incremental_matcher_free(&im);
+    return TEST_PASSED;
+}
+
+// Test an empty candidate set
+TestResult test_empty_candidates() {
+    IncrementalMatcher im;
+
+    ASSERT_EQUAL(0, incremental_matcher_init(&im, NULL, 0));
+    ASSERT_EQUAL(0, im.num_matches);
+    ASSERT_EQUAL(0, incremental_matcher_push(&im, 'x'));
+
+    incremental_matcher_free(&im);
+    return TEST_PASSED;
+}
+
+// Test streaming completion set: cap, total, and incremental LCP
+TestResult test_completion_set_streaming() {
+    CompletionSet set = {0};
+
+    completion_set_reset(&set);
+    ASSERT_EQUAL(0, completion_set_add(&set, "make_all", 0));
+    ASSERT_EQUAL(0, completion_set_add(&set, "make_clean", 1));
+    ASSERT_EQUAL(0, completion_set_add(&set, "make_check", 0));
+
+    ASSERT_EQUAL(3, set.total);
+    ASSERT_EQUAL(3, set.count);
+    ASSERT_STRING_EQUAL("make_all", completion_set_get(&set, 0));
+    ASSERT_STRING_EQUAL("make_clean/", completion_set_get(&set, 1));
+    ASSERT_STRING_EQUAL("make_", set.lcp);
+
+    // Past the cap, matches are counted but not stored
+    completion_set_reset(&set);
+    for (int i = 0; i < COMPLETION_SET_CAP + 50; i++) {
+        ASSERT_EQUAL(0, completion_set_add(&set, "entry", 0));
+    }
+    ASSERT_EQUAL(COMPLETION_SET_CAP + 50, set.total);
+    ASSERT_EQUAL(COMPLETION_SET_CAP, set.count);
+    ASSERT_STRING_EQUAL("entry", set.lcp);
+
+    free(set.pool);
+    return TEST_PASSED;
+}
+
+// Register all tests
+DEFINE_TEST_REGISTER(
+    REGISTER_TEST(suite, test_prefix_match);
+    REGISTER_TEST(suite, test_incremental_narrowing);
+    REGISTER_TEST(suite, test_incremental_widening);
+    REGISTER_TEST(suite, test_substring_match);
+    REGISTER_TEST(suite, test_empty_candidates);
+    REGISTER_TEST(suite, test_completion_set_streaming);
+)
+
+// Test entry point
+TEST_MAIN()
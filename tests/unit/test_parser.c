@@ -1,7 +1,11 @@
 #include "test_framework.h"
 #include "test_runner.h"
 #include "../../include/command/parser.h"
+#include "../../include/command/alias.h"
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 /**
  * Unit tests for the command parser
@@ -88,6 +92,246 @@ TestResult test_null_command() {
     return TEST_PASSED;
 }
 
+// Test the single-pass tokenizer with arguments and redirections
+TestResult test_tokenizer_redirections() {
+    char input[] = "echo hello > out.txt 2>> err.txt";
+    Command cmd = {0};
+
+    int result = parse_command_line(input, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("echo", cmd.argv[0]);
+    ASSERT_STRING_EQUAL("hello", cmd.argv[1]);
+    ASSERT_NULL(cmd.argv[2]);
+    ASSERT_NOT_NULL(cmd.redir.stdout_file);
+    ASSERT_STRING_EQUAL("out.txt", cmd.redir.stdout_file);
+    ASSERT_EQUAL(0, cmd.redir.append_stdout);
+    ASSERT_NOT_NULL(cmd.redir.stderr_file);
+    ASSERT_STRING_EQUAL("err.txt", cmd.redir.stderr_file);
+    ASSERT_EQUAL(1, cmd.redir.append_stderr);
+
+    free_command(&cmd);
+    return TEST_PASSED;
+}
+
+// Test the single-pass tokenizer with quotes and attached operators
+TestResult test_tokenizer_quotes() {
+    char input[] = "echo \"a > b\" hi>'my file'";
+    Command cmd = {0};
+
+    int result = parse_command_line(input, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(3, cmd.argc);
+    ASSERT_STRING_EQUAL("echo", cmd.argv[0]);
+    ASSERT_STRING_EQUAL("a > b", cmd.argv[1]);
+    ASSERT_STRING_EQUAL("hi", cmd.argv[2]);
+    ASSERT_NOT_NULL(cmd.redir.stdout_file);
+    ASSERT_STRING_EQUAL("my file", cmd.redir.stdout_file);
+
+    free_command(&cmd);
+    return TEST_PASSED;
+}
+
+// Test that a missing redirection target is rejected
+TestResult test_tokenizer_missing_target() {
+    char input[] = "echo hello >";
+    Command cmd = {0};
+
+    int result = parse_command_line(input, &cmd);
+
+    ASSERT_EQUAL(-1, result);
+
+    return TEST_PASSED;
+}
+
+// Test that an unquoted glob expands against the directory listing
+TestResult test_tokenizer_glob_expansion() {
+    char dir_template[] = "/tmp/cshell_glob_XXXXXX";
+    char *dir = mkdtemp(dir_template);
+    ASSERT_NOT_NULL(dir);
+
+    char path[3][256];
+    snprintf(path[0], sizeof(path[0]), "%s/a.log", dir);
+    snprintf(path[1], sizeof(path[1]), "%s/b.log", dir);
+    snprintf(path[2], sizeof(path[2]), "%s/c.txt", dir);
+    for (int i = 0; i < 3; i++) {
+        FILE *fp = fopen(path[i], "w");
+        ASSERT_NOT_NULL(fp);
+        fclose(fp);
+    }
+
+    char input[512];
+    snprintf(input, sizeof(input), "echo %s/*.log", dir);
+    Command cmd = {0};
+
+    int result = parse_command_line(input, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(3, cmd.argc);
+    ASSERT_STRING_EQUAL("echo", cmd.argv[0]);
+    // Matches come back in sorted order
+    ASSERT_STRING_EQUAL(path[0], cmd.argv[1]);
+    ASSERT_STRING_EQUAL(path[1], cmd.argv[2]);
+
+    for (int i = 0; i < 3; i++) {
+        unlink(path[i]);
+    }
+    rmdir(dir);
+    free_command(&cmd);
+    return TEST_PASSED;
+}
+
+// Test that quoted wildcards and unmatched patterns stay literal
+TestResult test_tokenizer_glob_literal() {
+    char quoted[] = "echo '*'.none";
+    Command cmd = {0};
+
+    int result = parse_command_line(quoted, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("*.none", cmd.argv[1]);
+    free_command(&cmd);
+
+    char unmatched[] = "echo *.no_such_suffix_zz";
+    memset(&cmd, 0, sizeof(cmd));
+
+    result = parse_command_line(unmatched, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("*.no_such_suffix_zz", cmd.argv[1]);
+
+    free_command(&cmd);
+    return TEST_PASSED;
+}
+
+// Test that a first-word alias is spliced into argv
+TestResult test_tokenizer_alias_expansion() {
+    ASSERT_EQUAL(0, alias_set("gs", "echo git \"status line\""));
+
+    char input[] = "gs --short";
+    Command cmd = {0};
+
+    int result = parse_command_line(input, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(4, cmd.argc);
+    ASSERT_STRING_EQUAL("echo", cmd.argv[0]);
+    ASSERT_STRING_EQUAL("git", cmd.argv[1]);
+    ASSERT_STRING_EQUAL("status line", cmd.argv[2]);
+    ASSERT_STRING_EQUAL("--short", cmd.argv[3]);
+    free_command(&cmd);
+
+    // Only the first word expands
+    char second[] = "echo gs";
+    memset(&cmd, 0, sizeof(cmd));
+
+    result = parse_command_line(second, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("gs", cmd.argv[1]);
+
+    alias_cleanup();
+    free_command(&cmd);
+    return TEST_PASSED;
+}
+
+// Test $VAR and ${VAR} expansion with quote rules
+TestResult test_tokenizer_variable_expansion() {
+    setenv("CSHELL_TEST_VAR", "hello world", 1);
+    unsetenv("CSHELL_TEST_UNSET");
+
+    // Unquoted expansion word-splits; double quotes keep it whole
+    char input[] = "echo $CSHELL_TEST_VAR \"${CSHELL_TEST_VAR}!\"";
+    Command cmd = {0};
+
+    int result = parse_command_line(input, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(4, cmd.argc);
+    ASSERT_STRING_EQUAL("hello", cmd.argv[1]);
+    ASSERT_STRING_EQUAL("world", cmd.argv[2]);
+    ASSERT_STRING_EQUAL("hello world!", cmd.argv[3]);
+    free_command(&cmd);
+
+    // Single quotes suppress expansion; unset variables expand empty
+    char quoted[] = "echo '$CSHELL_TEST_VAR' $CSHELL_TEST_UNSET";
+    memset(&cmd, 0, sizeof(cmd));
+
+    result = parse_command_line(quoted, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("$CSHELL_TEST_VAR", cmd.argv[1]);
+
+    unsetenv("CSHELL_TEST_VAR");
+    free_command(&cmd);
+    return TEST_PASSED;
+}
+
+// Test that bytes from variable values are data, not shell syntax
+TestResult test_tokenizer_expansion_literal() {
+    // A quote byte in a value must not open a quoted region
+    setenv("CSHELL_TEST_VAR", "a\"b", 1);
+    char quote_val[] = "echo \"$CSHELL_TEST_VAR\"";
+    Command cmd = {0};
+
+    int result = parse_command_line(quote_val, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("a\"b", cmd.argv[1]);
+    free_command(&cmd);
+
+    // A '>' in a value is an argument, not a redirection operator
+    setenv("CSHELL_TEST_VAR", "x > /tmp/cshell_injected", 1);
+    char redir_val[] = "echo $CSHELL_TEST_VAR";
+    memset(&cmd, 0, sizeof(cmd));
+
+    result = parse_command_line(redir_val, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(4, cmd.argc);
+    ASSERT_STRING_EQUAL("x", cmd.argv[1]);
+    ASSERT_STRING_EQUAL(">", cmd.argv[2]);
+    ASSERT_STRING_EQUAL("/tmp/cshell_injected", cmd.argv[3]);
+    ASSERT_NULL(cmd.redir.stdout_file);
+    free_command(&cmd);
+
+    // A wildcard in a value stays literal instead of globbing
+    setenv("CSHELL_TEST_VAR", "*", 1);
+    char glob_val[] = "echo $CSHELL_TEST_VAR";
+    memset(&cmd, 0, sizeof(cmd));
+
+    result = parse_command_line(glob_val, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("*", cmd.argv[1]);
+    free_command(&cmd);
+
+    // A real redirection after an expanded word still works
+    setenv("CSHELL_TEST_VAR", "value", 1);
+    char real_redir[] = "echo $CSHELL_TEST_VAR > target";
+    memset(&cmd, 0, sizeof(cmd));
+
+    result = parse_command_line(real_redir, &cmd);
+
+    ASSERT_EQUAL(0, result);
+    ASSERT_EQUAL(2, cmd.argc);
+    ASSERT_STRING_EQUAL("value", cmd.argv[1]);
+    ASSERT_NOT_NULL(cmd.redir.stdout_file);
+    ASSERT_STRING_EQUAL("target", cmd.redir.stdout_file);
+
+    unsetenv("CSHELL_TEST_VAR");
+    free_command(&cmd);
+    return TEST_PASSED;
+}
+
 // Register all tests
 DEFINE_TEST_REGISTER(
     REGISTER_TEST(suite, test_basic_command);
@@ -95,6 +339,14 @@ DEFINE_TEST_REGISTER(
     REGISTER_TEST(suite, test_escaped_command);
     REGISTER_TEST(suite, test_empty_command);
     REGISTER_TEST(suite, test_null_command);
+    REGISTER_TEST(suite, test_tokenizer_redirections);
+    REGISTER_TEST(suite, test_tokenizer_quotes);
+    REGISTER_TEST(suite, test_tokenizer_missing_target);
+    REGISTER_TEST(suite, test_tokenizer_glob_expansion);
+    REGISTER_TEST(suite, test_tokenizer_glob_literal);
+    REGISTER_TEST(suite, test_tokenizer_alias_expansion);
+    REGISTER_TEST(suite, test_tokenizer_variable_expansion);
+    REGISTER_TEST(suite, test_tokenizer_expansion_literal);
 )
 
 // Test entry point
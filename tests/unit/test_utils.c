@@ -6,11 +6,13 @@
 #include "../../include/utils/utils.h"
 #include "../../include/utils/string.h"
 #include "../../include/utils/path.h"
+#include "../../include/utils/dirjump.h"
 #include "../../include/utils/memory.h"
 #include "../framework/test_framework.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 /**
  * @brief Test safe_strcpy function
@@ -372,6 +374,78 @@ TestResult test_expand_tilde() {
     return TEST_PASSED;
 }
 
+/**
+ * @brief Test the string intern pool
+ */
+TestResult test_str_intern() {
+    // Equal contents yield the same pointer
+    const char *a = str_intern("echo", 4);
+    const char *b = str_intern("echo", 4);
+    ASSERT_NOT_NULL(a);
+    ASSERT_TRUE(a == b);
+    ASSERT_STRING_EQUAL("echo", a);
+
+    // Different contents yield a different pointer
+    const char *c = str_intern("gcc", 3);
+    ASSERT_NOT_NULL(c);
+    ASSERT_TRUE(a != c);
+
+    // Length is honoured: a prefix interns as its own string
+    const char *d = str_intern("echoes", 4);
+    ASSERT_TRUE(d == a);
+
+    return TEST_PASSED;
+}
+
+/**
+ * @brief Test the frecency directory jump index
+ */
+TestResult test_dirjump_resolve() {
+    char dir_a[] = "/tmp/cshell_jump_aXXXXXX";
+    char dir_b[] = "/tmp/cshell_jump_bXXXXXX";
+    ASSERT_NOT_NULL(mkdtemp(dir_a));
+    ASSERT_NOT_NULL(mkdtemp(dir_b));
+
+    // Hide $HOME so the lazy load on first record starts from an
+    // empty index instead of pulling in this user's real one
+    char *home = getenv("HOME");
+    char *saved_home = home ? strdup(home) : NULL;
+    unsetenv("HOME");
+
+    // Both match "cshell_jump"; b is visited more, so it wins
+    dirjump_record(dir_a);
+    dirjump_record(dir_b);
+    dirjump_record(dir_b);
+    dirjump_record(dir_b);
+
+    const char *result = dirjump_resolve("cshell_jump");
+    ASSERT_NOT_NULL(result);
+    ASSERT_STRING_EQUAL(dir_b, result);
+
+    // A more specific query still finds the lower-ranked entry
+    result = dirjump_resolve("cshell_jump_a");
+    ASSERT_NOT_NULL(result);
+    ASSERT_STRING_EQUAL(dir_a, result);
+
+    // Nothing matches an unknown name
+    ASSERT_NULL(dirjump_resolve("no_such_jump_target_zz"));
+
+    // A vanished directory is pruned rather than returned
+    rmdir(dir_a);
+    ASSERT_NULL(dirjump_resolve("cshell_jump_a"));
+
+    rmdir(dir_b);
+
+    // Drop the index; with $HOME still hidden nothing persists
+    dirjump_cleanup();
+    if (saved_home) {
+        setenv("HOME", saved_home, 1);
+        free(saved_home);
+    }
+
+    return TEST_PASSED;
+}
+
 /**
  * @brief Register all tests
  * 
@@ -390,6 +464,8 @@ void register_tests(TestSuite *suite) {
     test_suite_add(suite, "test_path_basename", test_path_basename);
     test_suite_add(suite, "test_memory_allocation", test_memory_allocation);
     test_suite_add(suite, "test_expand_tilde", test_expand_tilde);
+    test_suite_add(suite, "test_str_intern", test_str_intern);
+    test_suite_add(suite, "test_dirjump_resolve", test_dirjump_resolve);
 }
 
 /**